@@ -48,7 +48,10 @@ public class Pjc : ModuleRules
 				"IntroTutorials",
 				"UMGEditor",
 				"AssetManagerEditor",
-				"AssetTools"
+				"AssetTools",
+				"DirectoryWatcher",
+				"Json",
+				"SourceControl"
 			}
 		);
 	}
@@ -3,9 +3,50 @@
 #include "Commandlets/PjcCommandlet.h"
 
 #include "PjcSubsystem.h"
+#include "PjcConstants.h"
+#include "PjcPathScanner.h"
+#include "PjcPaths.h"
+#include "PjcContentIndex.h"
+// Engine Headers
+#include "Internationalization/Regex.h"
+#include "Misc/FileHelper.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogProjectCleanerCLI, Display, All);
 
+namespace PjcCommandletLocal
+{
+	// allocator is not replaced, calls are read from global FMalloc counters, that are updated only in builds with stats enabled.
+	// counters are process wide, but measured loops run on game thread while commandlet has no other work, so nearly all counted calls come from loop
+	template <typename FuncType>
+	static void Measure(const TCHAR* InName, const int32 InNumPaths, FuncType&& Func)
+	{
+#if STATS
+		const uint64 NumAllocsStart = FMalloc::TotalMallocCalls + FMalloc::TotalReallocCalls;
+#endif
+
+		const double TimeStart = FPlatformTime::Seconds();
+		const int32 NumConverted = Func();
+		const double Time = FPlatformTime::Seconds() - TimeStart;
+
+#if STATS
+		const FString NumAllocs = FString::Printf(TEXT("%llu"), FMalloc::TotalMallocCalls + FMalloc::TotalReallocCalls - NumAllocsStart);
+#else
+		const FString NumAllocs = TEXT("n/a");
+#endif
+
+		UE_LOG(
+			LogProjectCleanerCLI,
+			Display,
+			TEXT("%-32s - %d/%d paths in %.3f ms, %s allocations"),
+			InName,
+			NumConverted,
+			InNumPaths,
+			Time * 1000.0,
+			*NumAllocs
+		);
+	}
+}
+
 UPjcCommandlet::UPjcCommandlet()
 {
 	IsServer = false;
@@ -29,6 +70,26 @@ int32 UPjcCommandlet::Main(const FString& Params)
 	//- delete_folders_empty
 	//- delete_files_external
 	//- delete_files_corrupted
+	//- bench_indirect
+	//- bench_paths
+	//- dry_run (plan=<path> optional)
+	//- delete_by_plan (plan=<path> optional)
+	//- resume
+	//- quarantine
+	//- quarantine_restore (quarantine=<id> optional, latest by default)
+	//- quarantine_purge (quarantine=<id> optional, all by default)
+
+	if (bBenchIndirect)
+	{
+		BenchIndirectScan();
+		return 0;
+	}
+
+	if (bBenchPaths)
+	{
+		BenchPathConversion();
+		return 0;
+	}
 
 	if (UPjcSubsystem::ProjectHasRedirectors())
 	{
@@ -39,6 +100,37 @@ int32 UPjcCommandlet::Main(const FString& Params)
 		return 0;
 	}
 
+	if (bDryRun)
+	{
+		return UPjcSubsystem::DeleteAssetsUnusedDryRun(PlanFilePath) ? 0 : 1;
+	}
+
+	if (bDeleteByPlan)
+	{
+		return UPjcSubsystem::DeleteAssetsUnusedByPlan(PlanFilePath) ? 0 : 1;
+	}
+
+	if (bResume)
+	{
+		return UPjcSubsystem::DeleteAssetsUnusedResume() ? 0 : 1;
+	}
+
+	if (bQuarantine)
+	{
+		UPjcSubsystem::QuarantineUnused();
+		return 0;
+	}
+
+	if (bQuarantineRestore)
+	{
+		return UPjcSubsystem::QuarantineRestore(QuarantineId) ? 0 : 1;
+	}
+
+	if (bQuarantinePurge)
+	{
+		return UPjcSubsystem::QuarantinePurge(QuarantineId) ? 0 : 1;
+	}
+
 	TArray<FAssetData> AssetsAll;
 	TArray<FAssetData> AssetsUsed;
 	TArray<FAssetData> AssetsUnused;
@@ -68,6 +160,15 @@ int32 UPjcCommandlet::Main(const FString& Params)
 	UE_LOG(LogProjectCleanerCLI, Display, TEXT("======================================"));
 	StatsPrint(StatsBefore);
 
+	// suspect packages are registered, but have broken header or tail, those are only reported and never deleted
+	TArray<FString> FilesSuspect;
+	UPjcSubsystem::GetFilesSuspect(FilesSuspect);
+
+	for (const auto& File : FilesSuspect)
+	{
+		UE_LOG(LogProjectCleanerCLI, Warning, TEXT("Suspect package file (not deleted): %s"), *File);
+	}
+
 	if (bScanOnly) return 0;
 
 	if (bFullCleanup || bDeleteAssetsUnused)
@@ -124,6 +225,16 @@ void UPjcCommandlet::ParseCommandLinesArguments(const FString& Params)
 	TMap<FString, FString> Parameters;
 	ParseCommandLine(*Params, Tokens, Switches, Parameters);
 
+	if (const FString* PlanParam = Parameters.Find(TEXT("plan")))
+	{
+		PlanFilePath = *PlanParam;
+	}
+
+	if (const FString* QuarantineParam = Parameters.Find(TEXT("quarantine")))
+	{
+		QuarantineId = *QuarantineParam;
+	}
+
 	for (const auto& Switch : Switches)
 	{
 		if (Switch.Equals(TEXT("scan_only")))
@@ -132,6 +243,54 @@ void UPjcCommandlet::ParseCommandLinesArguments(const FString& Params)
 			break;
 		}
 
+		if (Switch.Equals(TEXT("bench_indirect")))
+		{
+			bBenchIndirect = true;
+			break;
+		}
+
+		if (Switch.Equals(TEXT("bench_paths")))
+		{
+			bBenchPaths = true;
+			break;
+		}
+
+		if (Switch.Equals(TEXT("dry_run")))
+		{
+			bDryRun = true;
+			break;
+		}
+
+		if (Switch.Equals(TEXT("delete_by_plan")))
+		{
+			bDeleteByPlan = true;
+			break;
+		}
+
+		if (Switch.Equals(TEXT("resume")))
+		{
+			bResume = true;
+			break;
+		}
+
+		if (Switch.Equals(TEXT("quarantine")))
+		{
+			bQuarantine = true;
+			break;
+		}
+
+		if (Switch.Equals(TEXT("quarantine_restore")))
+		{
+			bQuarantineRestore = true;
+			break;
+		}
+
+		if (Switch.Equals(TEXT("quarantine_purge")))
+		{
+			bQuarantinePurge = true;
+			break;
+		}
+
 		if (Switch.Equals(TEXT("full_cleanup")))
 		{
 			bFullCleanup = true;
@@ -169,3 +328,165 @@ void UPjcCommandlet::StatsPrint(const FCleanupStats& Stats)
 	UE_LOG(LogProjectCleanerCLI, Display, TEXT("Files Corrupted - %d"), Stats.NumFilesCorrupted);
 	UE_LOG(LogProjectCleanerCLI, Display, TEXT("Folders Empty - %d"), Stats.NumFoldersEmpty);
 }
+
+void UPjcCommandlet::BenchIndirectScan()
+{
+	TSet<FString> ScanFilesSet;
+	UPjcSubsystem::GetSourceAndConfigFiles(ScanFilesSet);
+
+	TArray<FString> ScanFiles = ScanFilesSet.Array();
+	ScanFiles.Sort();
+
+	// files are read once upfront, so both passes measure only searching
+	TArray<FString> FilesContentStr;
+	TArray<TArray<uint8>> FilesContentRaw;
+	FilesContentStr.SetNum(ScanFiles.Num());
+	FilesContentRaw.SetNum(ScanFiles.Num());
+
+	int64 TotalBytes = 0;
+	for (int32 FileIndex = 0; FileIndex < ScanFiles.Num(); ++FileIndex)
+	{
+		FFileHelper::LoadFileToString(FilesContentStr[FileIndex], *ScanFiles[FileIndex]);
+		FFileHelper::LoadFileToArray(FilesContentRaw[FileIndex], *ScanFiles[FileIndex], FILEREAD_Silent);
+		TotalBytes += FilesContentRaw[FileIndex].Num();
+	}
+
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("======================================"));
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("=====  Indirect Scan Benchmark  ======"));
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("======================================"));
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("Files - %d (%lld bytes)"), ScanFiles.Num(), TotalBytes);
+
+	// regex pass stays single threaded, FRegexPattern shares its implementation through a non thread safe shared pointer
+	const FRegexPattern Pattern{TEXT(R"(\/Game([A-Za-z0-9_.\/]+)\b)")};
+
+	int32 NumMatchesRegex = 0;
+	const double RegexTimeStart = FPlatformTime::Seconds();
+	for (const auto& FileContent : FilesContentStr)
+	{
+		FRegexMatcher Matcher(Pattern, FileContent);
+		while (Matcher.FindNext())
+		{
+			++NumMatchesRegex;
+		}
+	}
+	const double RegexTime = FPlatformTime::Seconds() - RegexTimeStart;
+
+	const FPjcPathScanner Scanner{TArray<FString>{PjcConstants::PathRoot.ToString()}};
+
+	int32 NumMatchesScanner = 0;
+	TArray<FPjcPathScanMatch> ScanMatches;
+	const double ScannerTimeStart = FPlatformTime::Seconds();
+	for (const auto& FileContent : FilesContentRaw)
+	{
+		ScanMatches.Reset();
+		Scanner.Scan(FileContent.GetData(), FileContent.Num(), ScanMatches);
+		NumMatchesScanner += ScanMatches.Num();
+	}
+	const double ScannerTime = FPlatformTime::Seconds() - ScannerTimeStart;
+
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("Regex - %d matches in %.3f ms"), NumMatchesRegex, RegexTime * 1000.0);
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("Scanner - %d matches in %.3f ms"), NumMatchesScanner, ScannerTime * 1000.0);
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("Speedup - %.2fx"), ScannerTime > 0.0 ? RegexTime / ScannerTime : 0.0);
+
+	if (NumMatchesRegex != NumMatchesScanner)
+	{
+		UE_LOG(LogProjectCleanerCLI, Warning, TEXT("Match count differs between regex and scanner"));
+	}
+}
+
+void UPjcCommandlet::BenchPathConversion()
+{
+	const FPjcContentIndex& ContentIndex = FPjcContentIndex::Get();
+
+	// same inputs as in scan, absolute file paths from content table and their /Game forms
+	TArray<FString> FilePaths;
+	TArray<FString> ObjectPaths;
+	FilePaths.Reserve(ContentIndex.GetFiles().Num());
+	ObjectPaths.Reserve(ContentIndex.GetFiles().Num());
+
+	for (const auto& File : ContentIndex.GetFiles())
+	{
+		FilePaths.Add(File.Path);
+		ObjectPaths.Add(UPjcSubsystem::PathConvertToObjectPath(File.Path));
+	}
+
+	const int32 NumPaths = FilePaths.Num();
+
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("======================================"));
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("==== Path Conversion Benchmark ======="));
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("======================================"));
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("Paths - %d"), NumPaths);
+
+	// builder is allocated before measuring and reused for every path, as it is done in scan loops
+	TStringBuilder<512> Builder;
+
+	PjcCommandletLocal::Measure(TEXT("Normalize (FString)"), NumPaths, [&]()
+	{
+		int32 Num = 0;
+		for (const auto& Path : FilePaths) Num += UPjcSubsystem::PathNormalize(Path).IsEmpty() ? 0 : 1;
+		return Num;
+	});
+
+	PjcCommandletLocal::Measure(TEXT("Normalize (View)"), NumPaths, [&]()
+	{
+		int32 Num = 0;
+		for (const auto& Path : FilePaths) Num += FPjcPaths::Normalize(Path, Builder) ? 1 : 0;
+		return Num;
+	});
+
+	PjcCommandletLocal::Measure(TEXT("ToAbsolute (FString)"), NumPaths, [&]()
+	{
+		int32 Num = 0;
+		for (const auto& Path : ObjectPaths) Num += UPjcSubsystem::PathConvertToAbsolute(Path).IsEmpty() ? 0 : 1;
+		return Num;
+	});
+
+	PjcCommandletLocal::Measure(TEXT("ToAbsolute (View)"), NumPaths, [&]()
+	{
+		int32 Num = 0;
+		for (const auto& Path : ObjectPaths) Num += FPjcPaths::ToAbsolute(Path, Builder) ? 1 : 0;
+		return Num;
+	});
+
+	PjcCommandletLocal::Measure(TEXT("ToRelative (FString)"), NumPaths, [&]()
+	{
+		int32 Num = 0;
+		for (const auto& Path : FilePaths) Num += UPjcSubsystem::PathConvertToRelative(Path).IsEmpty() ? 0 : 1;
+		return Num;
+	});
+
+	PjcCommandletLocal::Measure(TEXT("ToRelative (View)"), NumPaths, [&]()
+	{
+		int32 Num = 0;
+		for (const auto& Path : FilePaths) Num += FPjcPaths::ToRelative(Path, Builder) ? 1 : 0;
+		return Num;
+	});
+
+	PjcCommandletLocal::Measure(TEXT("ToObjectPath (FString)"), NumPaths, [&]()
+	{
+		int32 Num = 0;
+		for (const auto& Path : FilePaths) Num += UPjcSubsystem::PathConvertToObjectPath(Path).IsEmpty() ? 0 : 1;
+		return Num;
+	});
+
+	PjcCommandletLocal::Measure(TEXT("ToObjectPath (View)"), NumPaths, [&]()
+	{
+		int32 Num = 0;
+		for (const auto& Path : FilePaths) Num += FPjcPaths::FileToObjectPath(Path, Builder) ? 1 : 0;
+		return Num;
+	});
+
+	PjcCommandletLocal::Measure(TEXT("ExportTextToObjectPath (FString)"), NumPaths, [&]()
+	{
+		int32 Num = 0;
+		for (const auto& Path : ObjectPaths) Num += UPjcSubsystem::PathConvertExportTextToObjectPath(Path).IsEmpty() ? 0 : 1;
+		return Num;
+	});
+
+	PjcCommandletLocal::Measure(TEXT("ExportTextToObjectPath (View)"), NumPaths, [&]()
+	{
+		int32 Num = 0;
+		for (const auto& Path : ObjectPaths) Num += FPjcPaths::ExportTextToObjectPath(Path, Builder) ? 1 : 0;
+		return Num;
+	});
+}
@@ -28,11 +28,23 @@ public:
 private:
 	void ParseCommandLinesArguments(const FString& Params);
 	void StatsPrint(const FCleanupStats& Stats);
+	void BenchIndirectScan();
+	void BenchPathConversion();
 
 	bool bScanOnly = false;
+	bool bBenchIndirect = false;
+	bool bBenchPaths = false;
+	bool bDryRun = false;
+	bool bDeleteByPlan = false;
+	bool bResume = false;
+	bool bQuarantine = false;
+	bool bQuarantineRestore = false;
+	bool bQuarantinePurge = false;
 	bool bFullCleanup = false;
 	bool bDeleteAssetsUnused = false;
 	bool bDeleteFoldersEmpty = false;
 	bool bDeleteFilesExternal = false;
 	bool bDeleteFilesCorrupted = false;
+	FString PlanFilePath;
+	FString QuarantineId;
 };
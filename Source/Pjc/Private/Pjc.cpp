@@ -4,8 +4,10 @@
 #include "PjcCmds.h"
 #include "PjcStyles.h"
 #include "PjcConstants.h"
+#include "PjcSubsystem.h"
 #include "Slate/SPjcTabMain.h"
 // Engine Headers
+#include "ContentBrowserModule.h"
 #include "ToolMenus.h"
 #include "Widgets/Docking/SDockTab.h"
 
@@ -67,10 +69,24 @@ void FPjc::StartupModule()
 		.SetDisplayName(FText::FromString(PjcConstants::ModulePjcTitle.ToString()))
 		.SetMenuType(ETabSpawnerMenuType::Hidden)
 		.SetIcon(FPjcStyles::GetIcon("ProjectCleaner.Icon.Bin16"));
+
+	FContentBrowserModule& ContentBrowserModule = FModuleManager::LoadModuleChecked<FContentBrowserModule>(PjcConstants::ModuleContentBrowser);
+	FContentBrowserMenuExtender_SelectedAssets AssetMenuExtender = FContentBrowserMenuExtender_SelectedAssets::CreateStatic(&FPjc::OnExtendContentBrowserAssetMenu);
+	ContentBrowserExtenderHandle = AssetMenuExtender.GetHandle();
+	ContentBrowserModule.GetAllAssetViewContextMenuExtenders().Add(AssetMenuExtender);
 }
 
 void FPjc::ShutdownModule()
 {
+	if (FModuleManager::Get().IsModuleLoaded(PjcConstants::ModuleContentBrowser))
+	{
+		FContentBrowserModule& ContentBrowserModule = FModuleManager::GetModuleChecked<FContentBrowserModule>(PjcConstants::ModuleContentBrowser);
+		ContentBrowserModule.GetAllAssetViewContextMenuExtenders().RemoveAll([&](const FContentBrowserMenuExtender_SelectedAssets& Delegate)
+		{
+			return Delegate.GetHandle() == ContentBrowserExtenderHandle;
+		});
+	}
+
 	FGlobalTabmanager::Get()->UnregisterTabSpawner(PjcConstants::TabProjectCleaner);
 	UToolMenus::UnRegisterStartupCallback(this);
 	UToolMenus::UnregisterOwner(this);
@@ -90,4 +106,71 @@ bool FPjc::IsGameModule() const
 	return false;
 }
 
+TSharedRef<FExtender> FPjc::OnExtendContentBrowserAssetMenu(const TArray<FAssetData>& SelectedAssets)
+{
+	TSharedRef<FExtender> Extender = MakeShared<FExtender>();
+
+	Extender->AddMenuExtension(
+		"GetAssetActions",
+		EExtensionHook::After,
+		nullptr,
+		FMenuExtensionDelegate::CreateLambda([SelectedAssets](FMenuBuilder& MenuBuilder)
+		{
+			MenuBuilder.AddSubMenu(
+				FText::FromString(TEXT("Indirect References")),
+				FText::FromString(TEXT("Source and config file lines that reference selected assets. Based on last indirect assets scan.")),
+				FNewMenuDelegate::CreateStatic(&FPjc::CreateIndirectReferencesMenu, SelectedAssets),
+				false,
+				FPjcStyles::GetIcon("ProjectCleaner.Icon.Bin16")
+			);
+		})
+	);
+
+	return Extender;
+}
+
+void FPjc::CreateIndirectReferencesMenu(FMenuBuilder& MenuBuilder, TArray<FAssetData> SelectedAssets)
+{
+	bool bAnyReferenceFound = false;
+	TArray<FPjcFileInfo> FileInfos;
+
+	for (const auto& Asset : SelectedAssets)
+	{
+		UPjcSubsystem::GetAssetIndirectReferences(Asset, FileInfos);
+		if (FileInfos.Num() == 0) continue;
+
+		bAnyReferenceFound = true;
+
+		MenuBuilder.BeginSection(NAME_None, FText::FromName(Asset.AssetName));
+
+		for (const auto& FileInfo : FileInfos)
+		{
+			const FString FilePath = FileInfo.FilePath;
+			const int32 FileNum = FileInfo.FileNum;
+
+			MenuBuilder.AddMenuEntry(
+				FText::FromString(FString::Printf(TEXT("%s:%d"), *FPaths::GetCleanFilename(FilePath), FileNum)),
+				FText::FromString(FilePath),
+				FSlateIcon(),
+				FUIAction(FExecuteAction::CreateLambda([FilePath, FileNum]()
+				{
+					UPjcSubsystem::TryOpenFileAtLine(FilePath, FileNum);
+				}))
+			);
+		}
+
+		MenuBuilder.EndSection();
+	}
+
+	if (!bAnyReferenceFound)
+	{
+		MenuBuilder.AddMenuEntry(
+			FText::FromString(TEXT("No references found")),
+			FText::FromString(TEXT("Selected assets are not referenced in source or config files, or indirect assets scan was not run yet")),
+			FSlateIcon(),
+			FUIAction(FExecuteAction(), FCanExecuteAction::CreateLambda([]() { return false; }))
+		);
+	}
+}
+
 IMPLEMENT_MODULE(FPjc, Pjc)
@@ -86,6 +86,30 @@ void FPjcCmds::RegisterCommands()
 		FInputChord()
 	);
 
+	UI_COMMAND(
+		ResumeDeletion,
+		"Resume",
+		"Resume deletion of unused assets, that was interrupted, from last finished bucket",
+		EUserInterfaceActionType::Button,
+		FInputChord()
+	);
+
+	UI_COMMAND(
+		QuarantineProject,
+		"Quarantine",
+		"Move unused assets and external files to quarantine folder instead of deleting them. Quarantined files can be restored later.",
+		EUserInterfaceActionType::Button,
+		FInputChord()
+	);
+
+	UI_COMMAND(
+		QuarantineRestore,
+		"Restore",
+		"Restore files from latest quarantine",
+		EUserInterfaceActionType::Button,
+		FInputChord()
+	);
+
 	UI_COMMAND(
 		DeleteEmptyFolders,
 		"Delete Empty Folders",
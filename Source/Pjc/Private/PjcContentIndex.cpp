@@ -0,0 +1,372 @@
+﻿// Copyright Ashot Barkhudaryan. All Rights Reserved.
+
+#include "PjcContentIndex.h"
+#include "PjcConstants.h"
+#include "PjcDirectoryWalker.h"
+// Engine Headers
+#include "IDirectoryWatcher.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Containers/Ticker.h"
+#include "HAL/FileManager.h"
+
+namespace PjcContentIndexLocal
+{
+	static FDelegateHandle DelegateHandleTicker;
+	static FDelegateHandle DelegateHandleGatherer;
+	static double ChangeTimeFirst = 0.0;
+	static double ChangeTimeLast = 0.0;
+	static bool bGathererPending = false;
+}
+
+FPjcContentIndex FPjcContentIndex::Instance;
+uint64 FPjcContentIndex::BuildFrame = 0;
+bool FPjcContentIndex::bDirty = true;
+bool FPjcContentIndex::bLive = false;
+FPjcDelegateContentChanged FPjcContentIndex::DelegateContentChanged;
+
+const FPjcContentIndex& FPjcContentIndex::Get()
+{
+	check(IsInGameThread());
+
+	if (bDirty || (!bLive && BuildFrame != GFrameCounter))
+	{
+		Instance.Build();
+		BuildFrame = GFrameCounter;
+		bDirty = false;
+	}
+
+	return Instance;
+}
+
+void FPjcContentIndex::MarkDirty()
+{
+	bDirty = true;
+}
+
+void FPjcContentIndex::ApplyChanges(const TArray<FFileChangeData>& InChanges)
+{
+	check(IsInGameThread());
+
+	// table that waits for rebuild is built from scratch anyway
+	for (const auto& Change : InChanges)
+	{
+		if (bDirty) break;
+
+		if (!Instance.ApplyChange(Change))
+		{
+			bDirty = true;
+		}
+	}
+
+	// watcher reports changes in many small batches (copying folder, source control sync), views are refreshed once those settle
+	BroadcastDeferred();
+}
+
+void FPjcContentIndex::SetLive(const bool bInLive)
+{
+	bLive = bInLive;
+	bDirty = true;
+
+	FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(PjcConstants::ModuleAssetRegistry);
+
+	if (bInLive && AssetRegistryModule && !PjcContentIndexLocal::DelegateHandleGatherer.IsValid())
+	{
+		PjcContentIndexLocal::DelegateHandleGatherer = AssetRegistryModule->Get().OnFileLoadProgressUpdated().AddLambda([](const IAssetRegistry::FFileLoadProgressUpdateData& InData)
+		{
+			PjcContentIndexLocal::bGathererPending = InData.bIsDiscoveringAssetFiles || InData.NumAssetsProcessedByAssetRegistry < InData.NumTotalAssets;
+		});
+	}
+
+	if (bInLive) return;
+
+	if (AssetRegistryModule && PjcContentIndexLocal::DelegateHandleGatherer.IsValid())
+	{
+		AssetRegistryModule->Get().OnFileLoadProgressUpdated().Remove(PjcContentIndexLocal::DelegateHandleGatherer);
+	}
+
+	if (PjcContentIndexLocal::DelegateHandleTicker.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(PjcContentIndexLocal::DelegateHandleTicker);
+	}
+
+	PjcContentIndexLocal::DelegateHandleGatherer.Reset();
+	PjcContentIndexLocal::DelegateHandleTicker.Reset();
+	PjcContentIndexLocal::bGathererPending = false;
+}
+
+FPjcDelegateContentChanged& FPjcContentIndex::OnContentChanged()
+{
+	return DelegateContentChanged;
+}
+
+const TArray<FPjcContentFile>& FPjcContentIndex::GetFiles() const
+{
+	return Files;
+}
+
+const TArray<FPjcContentFolder>& FPjcContentIndex::GetFolders() const
+{
+	return Folders;
+}
+
+const FPjcContentFile* FPjcContentIndex::FindFile(const FString& InFilePath) const
+{
+	const int32* FileIndex = FileIndices.Find(InFilePath);
+	return FileIndex ? &Files[*FileIndex] : nullptr;
+}
+
+const FPjcContentFolder* FPjcContentIndex::FindFolder(const FString& InFolderPath) const
+{
+	const int32* FolderIndex = FolderIndices.Find(InFolderPath);
+	return FolderIndex ? &Folders[*FolderIndex] : nullptr;
+}
+
+int32 FPjcContentIndex::FindFolderIndex(const FString& InFolderPath) const
+{
+	const int32* FolderIndex = FolderIndices.Find(InFolderPath);
+	return FolderIndex ? *FolderIndex : INDEX_NONE;
+}
+
+int32 FPjcContentIndex::GetExtId(const FString& InExt) const
+{
+	const int32* ExtId = ExtIds.Find(InExt.Replace(TEXT("."), TEXT("")).ToLower());
+	return ExtId ? *ExtId : INDEX_NONE;
+}
+
+const FString& FPjcContentIndex::GetExt(const int32 InExtId) const
+{
+	return Extensions[InExtId];
+}
+
+TSet<int32> FPjcContentIndex::GetExtIds(const TSet<FString>& InExtensions) const
+{
+	TSet<int32> Ids;
+	Ids.Reserve(InExtensions.Num());
+
+	for (const auto& Ext : InExtensions)
+	{
+		const int32 ExtId = GetExtId(Ext);
+		if (ExtId == INDEX_NONE) continue;
+
+		Ids.Add(ExtId);
+	}
+
+	return Ids;
+}
+
+void FPjcContentIndex::Build()
+{
+	Files.Reset();
+	Folders.Reset();
+	Extensions.Reset();
+	ExtIds.Reset();
+	FileIndices.Reset();
+	FolderIndices.Reset();
+
+	const FString ContentDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir()).LeftChop(1);
+
+	// collections folders hold only .collection files, their parents (content root and current developer folder) are never reported as empty,
+	// so those subtrees are pruned instead of walked
+	FoldersPruned.Reset();
+	FoldersPruned.Emplace(ContentDir / TEXT("Collections"));
+	FoldersPruned.Emplace(ContentDir / TEXT("Developers") / FPaths::GameUserDeveloperFolderName() / TEXT("Collections"));
+
+	FPjcDirectoryWalker DirectoryWalker{true, true};
+	DirectoryWalker.SetPrune([FoldersPruned = FoldersPruned](const FString& InFolderPath)
+	{
+		return FoldersPruned.Contains(InFolderPath);
+	});
+
+	TArray<FPjcDirectoryEntry> FileEntries;
+	TArray<FPjcDirectoryEntry> FolderEntries;
+	DirectoryWalker.Walk(ContentDir, FileEntries, FolderEntries);
+
+	Files.Reserve(FileEntries.Num());
+	Folders.Reserve(FolderEntries.Num() + 1);
+
+	FPjcContentFolder RootFolder;
+	RootFolder.Path = ContentDir;
+	Folders.Emplace(MoveTemp(RootFolder));
+
+	for (auto& Entry : FolderEntries)
+	{
+		FPjcContentFolder Folder;
+		Folder.Path = MoveTemp(Entry.Path);
+		Folders.Emplace(MoveTemp(Folder));
+	}
+
+	for (auto& Entry : FileEntries)
+	{
+		const FString Ext = FPaths::GetExtension(Entry.Path, false).ToLower();
+		const int32* ExtIdPtr = ExtIds.Find(Ext);
+		const int32 ExtId = ExtIdPtr ? *ExtIdPtr : ExtIds.Add(Ext, Extensions.Add(Ext));
+
+		FPjcContentFile File;
+		File.Path = MoveTemp(Entry.Path);
+		File.Size = Entry.StatData.FileSize;
+		File.Time = Entry.StatData.ModificationTime;
+		File.ExtId = ExtId;
+		Files.Emplace(MoveTemp(File));
+	}
+
+	FolderIndices.Reserve(Folders.Num());
+	for (int32 FolderIndex = 0; FolderIndex < Folders.Num(); ++FolderIndex)
+	{
+		FolderIndices.Add(Folders[FolderIndex].Path, FolderIndex);
+	}
+
+	for (int32 FolderIndex = 1; FolderIndex < Folders.Num(); ++FolderIndex)
+	{
+		const int32* ParentIndex = FolderIndices.Find(FPaths::GetPath(Folders[FolderIndex].Path));
+		Folders[FolderIndex].ParentIndex = ParentIndex ? *ParentIndex : INDEX_NONE;
+	}
+
+	FileIndices.Reserve(Files.Num());
+	for (int32 FileIndex = 0; FileIndex < Files.Num(); ++FileIndex)
+	{
+		FPjcContentFile& File = Files[FileIndex];
+		FileIndices.Add(File.Path, FileIndex);
+
+		const int32* FolderIndex = FolderIndices.Find(FPaths::GetPath(File.Path));
+		File.FolderIndex = FolderIndex ? *FolderIndex : INDEX_NONE;
+
+		if (File.FolderIndex == INDEX_NONE) continue;
+
+		Folders[File.FolderIndex].NumFiles += 1;
+	}
+
+	// walker returns folders sorted by path, so every child has greater index than its parent
+	// and walking folders in reverse order finishes all children before their parent (post order)
+	for (int32 FolderIndex = Folders.Num() - 1; FolderIndex >= 0; --FolderIndex)
+	{
+		FPjcContentFolder& Folder = Folders[FolderIndex];
+		Folder.NumFilesTotal += Folder.NumFiles;
+		Folder.bEmpty = Folder.bEmpty && Folder.NumFiles == 0;
+
+		if (Folder.ParentIndex == INDEX_NONE) continue;
+
+		checkSlow(Folder.ParentIndex < FolderIndex);
+
+		FPjcContentFolder& Parent = Folders[Folder.ParentIndex];
+		Parent.NumFilesTotal += Folder.NumFilesTotal;
+		Parent.bEmpty = Parent.bEmpty && Folder.bEmpty;
+	}
+}
+
+bool FPjcContentIndex::ApplyChange(const FFileChangeData& InChange)
+{
+	FString Path = FPaths::ConvertRelativePathToFull(InChange.Filename);
+	FPaths::NormalizeFilename(Path);
+
+	if (Folders.Num() == 0 || !Path.StartsWith(Folders[0].Path + TEXT("/"))) return true;
+
+	for (const auto& FolderPruned : FoldersPruned)
+	{
+		if (Path.Equals(FolderPruned) || Path.StartsWith(FolderPruned + TEXT("/"))) return true;
+	}
+
+	// change action is not used, as watcher can coalesce several changes of same path, current file state is checked instead
+	const FFileStatData StatData = IFileManager::Get().GetStatData(*Path);
+
+	if (FolderIndices.Contains(Path))
+	{
+		// modified folder just had its content changed, that is reported separately
+		return StatData.bIsValid && StatData.bIsDirectory;
+	}
+
+	if (StatData.bIsValid && StatData.bIsDirectory) return false;
+
+	const int32* FileIndexPtr = FileIndices.Find(Path);
+
+	if (!StatData.bIsValid)
+	{
+		if (!FileIndexPtr) return true;
+
+		const int32 FileIndex = *FileIndexPtr;
+		AddFileCount(Files[FileIndex].FolderIndex, -1);
+
+		FileIndices.Remove(Path);
+		Files.RemoveAtSwap(FileIndex, 1, false);
+
+		if (Files.IsValidIndex(FileIndex))
+		{
+			FileIndices.Add(Files[FileIndex].Path, FileIndex);
+		}
+
+		return true;
+	}
+
+	if (FileIndexPtr)
+	{
+		Files[*FileIndexPtr].Size = StatData.FileSize;
+		Files[*FileIndexPtr].Time = StatData.ModificationTime;
+		return true;
+	}
+
+	const int32* FolderIndex = FolderIndices.Find(FPaths::GetPath(Path));
+	if (!FolderIndex) return false;
+
+	const FString Ext = FPaths::GetExtension(Path, false).ToLower();
+	const int32* ExtIdPtr = ExtIds.Find(Ext);
+	const int32 ExtId = ExtIdPtr ? *ExtIdPtr : ExtIds.Add(Ext, Extensions.Add(Ext));
+
+	FPjcContentFile File;
+	File.Path = Path;
+	File.Size = StatData.FileSize;
+	File.Time = StatData.ModificationTime;
+	File.ExtId = ExtId;
+	File.FolderIndex = *FolderIndex;
+
+	FileIndices.Add(Path, Files.Emplace(MoveTemp(File)));
+	AddFileCount(*FolderIndex, 1);
+
+	return true;
+}
+
+void FPjcContentIndex::BroadcastDeferred()
+{
+	PjcContentIndexLocal::ChangeTimeLast = FPlatformTime::Seconds();
+
+	if (PjcContentIndexLocal::DelegateHandleTicker.IsValid()) return;
+
+	PjcContentIndexLocal::ChangeTimeFirst = PjcContentIndexLocal::ChangeTimeLast;
+	PjcContentIndexLocal::DelegateHandleTicker = FTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateStatic(&FPjcContentIndex::BroadcastTick),
+		PjcConstants::ContentChangedDelay
+	);
+}
+
+bool FPjcContentIndex::BroadcastTick(float InDeltaTime)
+{
+	const double TimeNow = FPlatformTime::Seconds();
+	const bool bSettled = TimeNow - PjcContentIndexLocal::ChangeTimeLast >= PjcConstants::ContentChangedDelay && !PjcContentIndexLocal::bGathererPending;
+
+	// continuous stream of changes delays refresh only up to limit, but nothing is refreshed while initial asset discovery is running
+	if (!bSettled && TimeNow - PjcContentIndexLocal::ChangeTimeFirst < PjcConstants::ContentChangedDelayMax) return true;
+	if (IsAssetRegistryBusy()) return true;
+
+	PjcContentIndexLocal::DelegateHandleTicker.Reset();
+	DelegateContentChanged.Broadcast();
+
+	return false;
+}
+
+bool FPjcContentIndex::IsAssetRegistryBusy()
+{
+	const FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(PjcConstants::ModuleAssetRegistry);
+
+	return AssetRegistryModule && AssetRegistryModule->Get().IsLoadingAssets();
+}
+
+void FPjcContentIndex::AddFileCount(const int32 InFolderIndex, const int32 InDelta)
+{
+	if (!Folders.IsValidIndex(InFolderIndex)) return;
+
+	Folders[InFolderIndex].NumFiles += InDelta;
+
+	for (int32 Index = InFolderIndex; Index != INDEX_NONE; Index = Folders[Index].ParentIndex)
+	{
+		Folders[Index].NumFilesTotal += InDelta;
+		Folders[Index].bEmpty = Folders[Index].NumFilesTotal == 0;
+	}
+}
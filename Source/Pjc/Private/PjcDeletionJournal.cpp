@@ -0,0 +1,136 @@
+﻿// Copyright Ashot Barkhudaryan. All Rights Reserved.
+
+#include "PjcDeletionJournal.h"
+#include "PjcConstants.h"
+#include "PjcDeletionPlan.h"
+#include "Pjc.h"
+// Engine Headers
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+
+namespace PjcDeletionJournalLocal
+{
+	static const FString Header{TEXT("PJC_DELETION_JOURNAL 1")};
+	static const FString TagAsset{TEXT("ASSET ")};
+	static const FString TagPlan{TEXT("PLAN ")};
+	static const FString TagCommit{TEXT("COMMIT ")};
+}
+
+FPjcDeletionJournal::~FPjcDeletionJournal()
+{
+	Writer.Reset();
+}
+
+bool FPjcDeletionJournal::Begin(const FPjcDeletionPlan& InPlan)
+{
+	Writer.Reset(IFileManager::Get().CreateFileWriter(*GetJournalFilePath()));
+
+	if (!Writer)
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Failed to create deletion journal %s, deletion can not be resumed if interrupted"), *GetJournalFilePath());
+		return false;
+	}
+
+	FString Text = PjcDeletionJournalLocal::Header + LINE_TERMINATOR;
+
+	for (const auto& Asset : InPlan.GetSlice(0, InPlan.GetNumAssets()))
+	{
+		Text += PjcDeletionJournalLocal::TagAsset + Asset.ObjectPath.ToString() + LINE_TERMINATOR;
+	}
+
+	WriteLine(Text + PjcDeletionJournalLocal::TagPlan + LexToString(InPlan.GetNumAssets()));
+
+	return true;
+}
+
+void FPjcDeletionJournal::Commit(const int32 InNumAssetsDeleted)
+{
+	if (!Writer) return;
+
+	WriteLine(PjcDeletionJournalLocal::TagCommit + LexToString(InNumAssetsDeleted));
+}
+
+void FPjcDeletionJournal::Finish()
+{
+	if (!Writer) return;
+
+	Writer.Reset();
+	Discard();
+}
+
+bool FPjcDeletionJournal::Read(TArray<FName>& OutObjectPaths, int32& OutNumAssetsCommitted)
+{
+	OutObjectPaths.Reset();
+	OutNumAssetsCommitted = 0;
+
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *GetJournalFilePath())) return false;
+	if (Lines.Num() == 0 || !Lines[0].Equals(PjcDeletionJournalLocal::Header)) return false;
+
+	bool bPlanComplete = false;
+
+	for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+	{
+		const FString& Line = Lines[LineIndex];
+
+		if (!bPlanComplete && Line.StartsWith(PjcDeletionJournalLocal::TagAsset, ESearchCase::CaseSensitive))
+		{
+			OutObjectPaths.Emplace(FName{*Line.RightChop(PjcDeletionJournalLocal::TagAsset.Len())});
+			continue;
+		}
+
+		if (!bPlanComplete && Line.StartsWith(PjcDeletionJournalLocal::TagPlan, ESearchCase::CaseSensitive))
+		{
+			int32 NumAssets = 0;
+			LexFromString(NumAssets, *Line.RightChop(PjcDeletionJournalLocal::TagPlan.Len()));
+
+			bPlanComplete = NumAssets == OutObjectPaths.Num();
+			if (!bPlanComplete) break;
+
+			continue;
+		}
+
+		// last line can be torn by crash, only fully written positions are taken
+		if (bPlanComplete && Line.StartsWith(PjcDeletionJournalLocal::TagCommit, ESearchCase::CaseSensitive))
+		{
+			int32 NumAssetsCommitted = 0;
+			LexFromString(NumAssetsCommitted, *Line.RightChop(PjcDeletionJournalLocal::TagCommit.Len()));
+
+			if (NumAssetsCommitted <= OutNumAssetsCommitted || NumAssetsCommitted > OutObjectPaths.Num()) continue;
+
+			OutNumAssetsCommitted = NumAssetsCommitted;
+		}
+	}
+
+	if (!bPlanComplete)
+	{
+		OutObjectPaths.Reset();
+		OutNumAssetsCommitted = 0;
+	}
+
+	return bPlanComplete;
+}
+
+bool FPjcDeletionJournal::Exists()
+{
+	return IFileManager::Get().FileExists(*GetJournalFilePath());
+}
+
+void FPjcDeletionJournal::Discard()
+{
+	IFileManager::Get().Delete(*GetJournalFilePath(), false, true, true);
+}
+
+FString FPjcDeletionJournal::GetJournalFilePath()
+{
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / PjcConstants::PathSavedDirName / PjcConstants::FileDeletionJournalName);
+}
+
+void FPjcDeletionJournal::WriteLine(const FString& InLine)
+{
+	const FTCHARToUTF8 LineUtf8{*(InLine + LINE_TERMINATOR)};
+	Writer->Serialize(const_cast<ANSICHAR*>(LineUtf8.Get()), LineUtf8.Length());
+
+	// every line is pushed to disk right away, so journal survives editor crash
+	Writer->Flush();
+}
@@ -0,0 +1,587 @@
+﻿// Copyright Ashot Barkhudaryan. All Rights Reserved.
+
+#include "PjcDeletionPlan.h"
+#include "PjcConstants.h"
+#include "PjcContentIndex.h"
+#include "PjcPaths.h"
+#include "PjcSubsystem.h"
+#include "Pjc.h"
+// Engine Headers
+#include "Algo/BinarySearch.h"
+#include "Dom/JsonObject.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace PjcDeletionPlanLocal
+{
+	static constexpr int32 Version = 1;
+
+	static TArray<TSharedPtr<FJsonValue>> ToJsonValues(const TArray<FString>& InStrings)
+	{
+		TArray<TSharedPtr<FJsonValue>> Values;
+		Values.Reserve(InStrings.Num());
+
+		for (const auto& String : InStrings)
+		{
+			Values.Emplace(MakeShared<FJsonValueString>(String));
+		}
+
+		return Values;
+	}
+
+	struct FNode
+	{
+		TArray<int32> AssetIndices;
+		// edges go from referencer to referenced package, both in deleted set
+		TArray<int32> Edges;
+	};
+
+	struct FFrame
+	{
+		int32 Node = INDEX_NONE;
+		int32 EdgeIndex = 0;
+	};
+
+	// Tarjan strongly connected components, iterative so long reference chains can not overflow call stack
+	static int32 GetComponents(const TArray<FNode>& Nodes, TArray<int32>& OutComponents)
+	{
+		TArray<int32> NodeOrder;
+		TArray<int32> LowLinks;
+		TBitArray<> OnStack{false, Nodes.Num()};
+		TArray<int32> Stack;
+		TArray<FFrame> CallStack;
+
+		NodeOrder.Init(INDEX_NONE, Nodes.Num());
+		LowLinks.Init(INDEX_NONE, Nodes.Num());
+		OutComponents.Init(INDEX_NONE, Nodes.Num());
+
+		int32 NextOrder = 0;
+		int32 NumComponents = 0;
+
+		const auto Visit = [&](const int32 Node)
+		{
+			NodeOrder[Node] = NextOrder;
+			LowLinks[Node] = NextOrder;
+			++NextOrder;
+
+			Stack.Push(Node);
+			OnStack[Node] = true;
+			CallStack.Add(FFrame{Node, 0});
+		};
+
+		for (int32 RootNode = 0; RootNode < Nodes.Num(); ++RootNode)
+		{
+			if (NodeOrder[RootNode] != INDEX_NONE) continue;
+
+			Visit(RootNode);
+
+			while (CallStack.Num() > 0)
+			{
+				const int32 Node = CallStack.Last().Node;
+				const TArray<int32>& Edges = Nodes[Node].Edges;
+
+				if (CallStack.Last().EdgeIndex < Edges.Num())
+				{
+					const int32 NextNode = Edges[CallStack.Last().EdgeIndex++];
+
+					if (NodeOrder[NextNode] == INDEX_NONE)
+					{
+						Visit(NextNode);
+					}
+					else if (OnStack[NextNode])
+					{
+						LowLinks[Node] = FMath::Min(LowLinks[Node], NodeOrder[NextNode]);
+					}
+
+					continue;
+				}
+
+				CallStack.Pop(false);
+
+				if (LowLinks[Node] == NodeOrder[Node])
+				{
+					int32 ComponentNode;
+					do
+					{
+						ComponentNode = Stack.Pop(false);
+						OnStack[ComponentNode] = false;
+						OutComponents[ComponentNode] = NumComponents;
+					}
+					while (ComponentNode != Node);
+
+					++NumComponents;
+				}
+
+				if (CallStack.Num() > 0)
+				{
+					const int32 ParentNode = CallStack.Last().Node;
+					LowLinks[ParentNode] = FMath::Min(LowLinks[ParentNode], LowLinks[Node]);
+				}
+			}
+		}
+
+		return NumComponents;
+	}
+}
+
+void FPjcDeletionPlan::Build(const TArray<FAssetData>& InAssets, const int32 InBucketSize)
+{
+	using namespace PjcDeletionPlanLocal;
+
+	Assets.Reset(InAssets.Num());
+	BucketStarts.Reset();
+	ComponentStarts.Reset();
+	Files.Reset();
+	FoldersAffected.Reset();
+	FoldersEmptyPredicted.Reset();
+	SizeTotal = 0;
+
+	const double TimeStart = FPlatformTime::Seconds();
+
+	// graph nodes are packages, package can contain several assets
+	TArray<FNode> Nodes;
+	TMap<FName, int32> NodesByPackage;
+	NodesByPackage.Reserve(InAssets.Num());
+
+	for (int32 AssetIndex = 0; AssetIndex < InAssets.Num(); ++AssetIndex)
+	{
+		const int32* NodePtr = NodesByPackage.Find(InAssets[AssetIndex].PackageName);
+		const int32 Node = NodePtr ? *NodePtr : NodesByPackage.Add(InAssets[AssetIndex].PackageName, Nodes.AddDefaulted());
+
+		Nodes[Node].AssetIndices.Add(AssetIndex);
+	}
+
+	// referencers of every package are queried once, referencers outside of deleted set do not affect order
+	TArray<FName> Refs;
+	for (const auto& Package : NodesByPackage)
+	{
+		Refs.Reset();
+		UPjcSubsystem::GetModuleAssetRegistry().Get().GetReferencers(Package.Key, Refs);
+
+		for (const auto& Ref : Refs)
+		{
+			const int32* RefNode = NodesByPackage.Find(Ref);
+			if (!RefNode || *RefNode == Package.Value) continue;
+
+			Nodes[*RefNode].Edges.Add(Package.Value);
+		}
+	}
+
+	TArray<int32> Components;
+	const int32 NumComponents = GetComponents(Nodes, Components);
+
+	TArray<TArray<int32>> ComponentNodes;
+	TArray<TArray<int32>> ComponentEdges;
+	TArray<int32> InDegrees;
+	ComponentNodes.SetNum(NumComponents);
+	ComponentEdges.SetNum(NumComponents);
+	InDegrees.Init(0, NumComponents);
+
+	for (int32 Node = 0; Node < Nodes.Num(); ++Node)
+	{
+		const int32 Component = Components[Node];
+		ComponentNodes[Component].Add(Node);
+
+		for (const int32 NextNode : Nodes[Node].Edges)
+		{
+			const int32 NextComponent = Components[NextNode];
+			if (NextComponent == Component) continue;
+
+			ComponentEdges[Component].Add(NextComponent);
+			++InDegrees[NextComponent];
+		}
+	}
+
+	// Kahn, components without referencers go first, every processed component releases components it references
+	TArray<int32> Queue;
+	Queue.Reserve(NumComponents);
+
+	for (int32 Component = 0; Component < NumComponents; ++Component)
+	{
+		if (InDegrees[Component] == 0)
+		{
+			Queue.Add(Component);
+		}
+	}
+
+	int32 BucketNum = 0;
+	int32 NumCycles = 0;
+
+	for (int32 QueueIndex = 0; QueueIndex < Queue.Num(); ++QueueIndex)
+	{
+		const int32 Component = Queue[QueueIndex];
+
+		NumCycles += ComponentNodes[Component].Num() > 1 ? 1 : 0;
+
+		int32 ComponentNum = 0;
+		for (const int32 Node : ComponentNodes[Component])
+		{
+			ComponentNum += Nodes[Node].AssetIndices.Num();
+		}
+
+		// component is never split, so it starts new bucket if it does not fit into current one
+		if (BucketStarts.Num() == 0 || (BucketNum > 0 && BucketNum + ComponentNum > InBucketSize))
+		{
+			BucketStarts.Add(Assets.Num());
+			BucketNum = 0;
+		}
+
+		ComponentStarts.Add(Assets.Num());
+
+		for (const int32 Node : ComponentNodes[Component])
+		{
+			for (const int32 AssetIndex : Nodes[Node].AssetIndices)
+			{
+				Assets.Add(InAssets[AssetIndex]);
+			}
+		}
+
+		BucketNum += ComponentNum;
+
+		for (const int32 NextComponent : ComponentEdges[Component])
+		{
+			if (--InDegrees[NextComponent] == 0)
+			{
+				Queue.Add(NextComponent);
+			}
+		}
+	}
+
+	// condensed graph has no cycles, so every component is reached
+	check(Queue.Num() == NumComponents);
+
+	BuildEstimate();
+
+	UE_LOG(
+		LogProjectCleaner,
+		Display,
+		TEXT("Deletion plan: %d assets, %d packages, %d cycles collapsed, %d buckets, built in %.3f seconds"),
+		Assets.Num(),
+		Nodes.Num(),
+		NumCycles,
+		BucketStarts.Num(),
+		FPlatformTime::Seconds() - TimeStart
+	);
+}
+
+bool FPjcDeletionPlan::Save(const FString& InFilePath) const
+{
+	const TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetNumberField(TEXT("Version"), PjcDeletionPlanLocal::Version);
+	Root->SetStringField(TEXT("Created"), FDateTime::Now().ToString());
+	Root->SetNumberField(TEXT("NumAssets"), Assets.Num());
+	Root->SetNumberField(TEXT("SizeTotal"), SizeTotal);
+
+	TArray<TSharedPtr<FJsonValue>> BucketValues;
+	for (int32 BucketIndex = 0; BucketIndex < GetNumBuckets(); ++BucketIndex)
+	{
+		TArray<TSharedPtr<FJsonValue>> AssetValues;
+		for (const auto& Asset : GetBucket(BucketIndex))
+		{
+			AssetValues.Emplace(MakeShared<FJsonValueString>(Asset.ObjectPath.ToString()));
+		}
+
+		BucketValues.Emplace(MakeShared<FJsonValueArray>(AssetValues));
+	}
+
+	// time is stored in ticks as string, because json numbers can not hold int64 precisely
+	TArray<TSharedPtr<FJsonValue>> FileValues;
+	for (const auto& File : Files)
+	{
+		const TSharedRef<FJsonObject> FileObject = MakeShared<FJsonObject>();
+		FileObject->SetStringField(TEXT("Path"), File.Path);
+		FileObject->SetNumberField(TEXT("Size"), File.Size);
+		FileObject->SetStringField(TEXT("Time"), LexToString(File.Time.GetTicks()));
+
+		FileValues.Emplace(MakeShared<FJsonValueObject>(FileObject));
+	}
+
+	Root->SetArrayField(TEXT("Buckets"), BucketValues);
+	Root->SetArrayField(TEXT("Files"), FileValues);
+	Root->SetArrayField(TEXT("FoldersAffected"), PjcDeletionPlanLocal::ToJsonValues(FoldersAffected));
+	Root->SetArrayField(TEXT("FoldersEmptyPredicted"), PjcDeletionPlanLocal::ToJsonValues(FoldersEmptyPredicted));
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	if (!FJsonSerializer::Serialize(Root, Writer)) return false;
+
+	return FFileHelper::SaveStringToFile(Json, *InFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
+
+bool FPjcDeletionPlan::Load(const FString& InFilePath)
+{
+	Assets.Reset();
+	BucketStarts.Reset();
+	ComponentStarts.Reset();
+	Files.Reset();
+	FoldersAffected.Reset();
+	FoldersEmptyPredicted.Reset();
+	SizeTotal = 0;
+
+	FString Json;
+	if (!FFileHelper::LoadFileToString(Json, *InFilePath))
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Failed to read deletion plan %s"), *InFilePath);
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> Root;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Deletion plan %s is not valid json"), *InFilePath);
+		return false;
+	}
+
+	if (static_cast<int32>(Root->GetNumberField(TEXT("Version"))) != PjcDeletionPlanLocal::Version)
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Deletion plan %s was written by different plugin version"), *InFilePath);
+		return false;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* BucketValues = nullptr;
+	const TArray<TSharedPtr<FJsonValue>>* FileValues = nullptr;
+	if (!Root->TryGetArrayField(TEXT("Buckets"), BucketValues) || !Root->TryGetArrayField(TEXT("Files"), FileValues))
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Deletion plan %s has no buckets or files"), *InFilePath);
+		return false;
+	}
+
+	bool bValid = true;
+
+	for (const auto& BucketValue : *BucketValues)
+	{
+		const int32 BucketStart = Assets.Num();
+
+		for (const auto& AssetValue : BucketValue->AsArray())
+		{
+			const FString ObjectPath = AssetValue->AsString();
+			const FAssetData Asset = UPjcSubsystem::GetModuleAssetRegistry().Get().GetAssetByObjectPath(FName{*ObjectPath});
+
+			if (!Asset.IsValid())
+			{
+				UE_LOG(LogProjectCleaner, Warning, TEXT("Planned asset %s no longer exists"), *ObjectPath);
+				bValid = false;
+				continue;
+			}
+
+			Assets.Emplace(Asset);
+		}
+
+		// empty buckets (written by hand or with all assets gone) are skipped, slices never end where they start
+		if (Assets.Num() > BucketStart)
+		{
+			BucketStarts.Add(BucketStart);
+		}
+	}
+
+	for (const auto& FileValue : *FileValues)
+	{
+		const TSharedPtr<FJsonObject> FileObject = FileValue->AsObject();
+		if (!FileObject.IsValid()) continue;
+
+		int64 Ticks = 0;
+		LexFromString(Ticks, *FileObject->GetStringField(TEXT("Time")));
+
+		FPjcDeletionPlanFile File;
+		File.Path = FileObject->GetStringField(TEXT("Path"));
+		File.Size = static_cast<int64>(FileObject->GetNumberField(TEXT("Size")));
+		File.Time = FDateTime{Ticks};
+		SizeTotal += File.Size;
+
+		Files.Emplace(MoveTemp(File));
+	}
+
+	// components are not stored in plan file, so every bucket is kept whole
+	ComponentStarts = BucketStarts;
+
+	Root->TryGetStringArrayField(TEXT("FoldersAffected"), FoldersAffected);
+	Root->TryGetStringArrayField(TEXT("FoldersEmptyPredicted"), FoldersEmptyPredicted);
+
+	return bValid;
+}
+
+bool FPjcDeletionPlan::Verify(const TArray<FAssetData>& InAssetsUnused, TArray<FString>& OutErrors) const
+{
+	OutErrors.Reset();
+
+	TSet<FName> ObjectPathsPlanned;
+	ObjectPathsPlanned.Reserve(Assets.Num());
+
+	for (const auto& Asset : Assets)
+	{
+		ObjectPathsPlanned.Add(Asset.ObjectPath);
+	}
+
+	TSet<FName> ObjectPathsUnused;
+	ObjectPathsUnused.Reserve(InAssetsUnused.Num());
+
+	for (const auto& Asset : InAssetsUnused)
+	{
+		ObjectPathsUnused.Add(Asset.ObjectPath);
+
+		if (!ObjectPathsPlanned.Contains(Asset.ObjectPath))
+		{
+			OutErrors.Emplace(FString::Printf(TEXT("Asset %s is unused, but not planned"), *Asset.ObjectPath.ToString()));
+		}
+	}
+
+	for (const auto& ObjectPath : ObjectPathsPlanned)
+	{
+		if (!ObjectPathsUnused.Contains(ObjectPath))
+		{
+			OutErrors.Emplace(FString::Printf(TEXT("Asset %s is planned, but no longer unused"), *ObjectPath.ToString()));
+		}
+	}
+
+	const FPjcContentIndex& ContentIndex = FPjcContentIndex::Get();
+
+	for (const auto& File : Files)
+	{
+		const FPjcContentFile* ContentFile = ContentIndex.FindFile(File.Path);
+
+		if (!ContentFile)
+		{
+			OutErrors.Emplace(FString::Printf(TEXT("File %s no longer exists"), *File.Path));
+			continue;
+		}
+
+		if (ContentFile->Size != File.Size || ContentFile->Time != File.Time)
+		{
+			OutErrors.Emplace(FString::Printf(TEXT("File %s was changed"), *File.Path));
+		}
+	}
+
+	return OutErrors.Num() == 0;
+}
+
+int32 FPjcDeletionPlan::GetNumAssets() const
+{
+	return Assets.Num();
+}
+
+int32 FPjcDeletionPlan::GetNumBuckets() const
+{
+	return BucketStarts.Num();
+}
+
+int64 FPjcDeletionPlan::GetSizeTotal() const
+{
+	return SizeTotal;
+}
+
+const TArray<FString>& FPjcDeletionPlan::GetFoldersAffected() const
+{
+	return FoldersAffected;
+}
+
+const TArray<FString>& FPjcDeletionPlan::GetFoldersEmptyPredicted() const
+{
+	return FoldersEmptyPredicted;
+}
+
+TArrayView<const FAssetData> FPjcDeletionPlan::GetBucket(const int32 InBucketIndex) const
+{
+	check(BucketStarts.IsValidIndex(InBucketIndex));
+
+	const int32 Start = BucketStarts[InBucketIndex];
+	const int32 End = BucketStarts.IsValidIndex(InBucketIndex + 1) ? BucketStarts[InBucketIndex + 1] : Assets.Num();
+
+	return TArrayView<const FAssetData>{Assets.GetData() + Start, End - Start};
+}
+
+int32 FPjcDeletionPlan::GetSliceEnd(const int32 InStart, const int32 InMaxSize) const
+{
+	check(Assets.IsValidIndex(InStart));
+
+	const int32 Limit = InStart + FMath::Max(1, InMaxSize);
+	if (Limit >= Assets.Num()) return Assets.Num();
+
+	const int32 FirstComponent = Algo::LowerBound(ComponentStarts, InStart);
+	check(ComponentStarts.IsValidIndex(FirstComponent) && ComponentStarts[FirstComponent] == InStart);
+
+	const int32 FirstComponentEnd = ComponentStarts.IsValidIndex(FirstComponent + 1) ? ComponentStarts[FirstComponent + 1] : Assets.Num();
+	const int32 LastBoundary = ComponentStarts[Algo::UpperBound(ComponentStarts, Limit) - 1];
+
+	return FMath::Max(FirstComponentEnd, LastBoundary);
+}
+
+TArrayView<const FAssetData> FPjcDeletionPlan::GetSlice(const int32 InStart, const int32 InEnd) const
+{
+	check(InStart >= 0 && InStart <= InEnd && InEnd <= Assets.Num());
+
+	return TArrayView<const FAssetData>{Assets.GetData() + InStart, InEnd - InStart};
+}
+
+void FPjcDeletionPlan::BuildEstimate()
+{
+	const FPjcContentIndex& ContentIndex = FPjcContentIndex::Get();
+	const TArray<FPjcContentFolder>& ContentFolders = ContentIndex.GetFolders();
+
+	TArray<int32> NumFilesDeleted;
+	NumFilesDeleted.Init(0, ContentFolders.Num());
+
+	TSet<FName> PackagesVisited;
+	TStringBuilder<256> PackageFile;
+
+	// package is deleted with all its files, like .uasset and its sidecars
+	for (const auto& Asset : Assets)
+	{
+		bool bVisited = false;
+		PackagesVisited.Add(Asset.PackageName, &bVisited);
+		if (bVisited) continue;
+
+		if (!FPjcPaths::ToAbsolute(Asset.PackageName.ToString(), PackageFile)) continue;
+
+		const int32 PackageFileLen = PackageFile.Len();
+		for (const TSet<FString>* Extensions : {&PjcConstants::PackageFileExtensions, &PjcConstants::SidecarFileExtensions})
+		{
+			for (const auto& Ext : *Extensions)
+			{
+				PackageFile.RemoveSuffix(PackageFile.Len() - PackageFileLen);
+				PackageFile << TEXT(".") << *Ext;
+
+				const FPjcContentFile* ContentFile = ContentIndex.FindFile(FString{PackageFile.Len(), PackageFile.GetData()});
+				if (!ContentFile) continue;
+
+				FPjcDeletionPlanFile File;
+				File.Path = ContentFile->Path;
+				File.Size = ContentFile->Size;
+				File.Time = ContentFile->Time;
+				SizeTotal += File.Size;
+				Files.Emplace(MoveTemp(File));
+
+				if (ContentFile->FolderIndex == INDEX_NONE) continue;
+
+				++NumFilesDeleted[ContentFile->FolderIndex];
+			}
+		}
+	}
+
+	TStringBuilder<256> FolderPathRel;
+	for (int32 FolderIndex = 1; FolderIndex < ContentFolders.Num(); ++FolderIndex)
+	{
+		if (NumFilesDeleted[FolderIndex] == 0) continue;
+		if (!FPjcPaths::ToRelative(ContentFolders[FolderIndex].Path, FolderPathRel)) continue;
+
+		FoldersAffected.Emplace(FString{FolderPathRel.Len(), FolderPathRel.GetData()});
+	}
+
+	// bottom up pass, folder becomes empty if all files of its subtree are deleted
+	for (int32 FolderIndex = ContentFolders.Num() - 1; FolderIndex > 0; --FolderIndex)
+	{
+		const FPjcContentFolder& Folder = ContentFolders[FolderIndex];
+
+		if (!Folder.bEmpty && Folder.NumFilesTotal == NumFilesDeleted[FolderIndex] && FPjcPaths::ToRelative(Folder.Path, FolderPathRel))
+		{
+			FoldersEmptyPredicted.Emplace(FString{FolderPathRel.Len(), FolderPathRel.GetData()});
+		}
+
+		if (Folder.ParentIndex == INDEX_NONE) continue;
+
+		NumFilesDeleted[Folder.ParentIndex] += NumFilesDeleted[FolderIndex];
+	}
+
+	FoldersEmptyPredicted.Sort();
+}
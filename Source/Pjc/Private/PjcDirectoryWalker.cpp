@@ -0,0 +1,243 @@
+﻿// Copyright Ashot Barkhudaryan. All Rights Reserved.
+
+#include "PjcDirectoryWalker.h"
+// Engine Headers
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Misc/App.h"
+
+namespace PjcDirectoryWalkerLocal
+{
+	static constexpr int32 MaxWorkers = 16;
+	// idle workers are woken by event, timeout only guards against wakeup that was reset by other idle worker
+	static constexpr uint32 IdleWaitMs = 5;
+
+	struct FWorker
+	{
+		// owner takes newest directories from back (depth first), thieves take oldest from front (biggest subtrees)
+		FCriticalSection QueueLock;
+		TArray<FString> Queue;
+		int32 QueueHead = 0;
+
+		// results are written to per worker buffers without locking and merged after walk
+		TArray<FPjcDirectoryEntry> Files;
+		TArray<FPjcDirectoryEntry> Folders;
+
+		void Push(FString&& InDir)
+		{
+			FScopeLock ScopeLock{&QueueLock};
+			Queue.Emplace(MoveTemp(InDir));
+		}
+
+		bool PopBack(FString& OutDir)
+		{
+			FScopeLock ScopeLock{&QueueLock};
+			if (Queue.Num() == QueueHead) return false;
+
+			OutDir = Queue.Pop(false);
+			ResetIfEmpty();
+			return true;
+		}
+
+		bool PopFront(FString& OutDir)
+		{
+			FScopeLock ScopeLock{&QueueLock};
+			if (Queue.Num() == QueueHead) return false;
+
+			OutDir = MoveTemp(Queue[QueueHead++]);
+			ResetIfEmpty();
+			return true;
+		}
+
+	private:
+		void ResetIfEmpty()
+		{
+			if (Queue.Num() != QueueHead) return;
+
+			Queue.Reset();
+			QueueHead = 0;
+		}
+	};
+
+	struct FWalkState
+	{
+		TArray<TUniquePtr<FWorker>> Workers;
+		// directories pushed but not listed yet, walk is finished when it drops to zero
+		FThreadSafeCounter NumPendingDirs;
+		FThreadSafeCounter NumIdleWorkers;
+		FEvent* WorkEvent = nullptr;
+		bool bRecursive = true;
+		bool bStat = false;
+		const FPjcDirectoryWalker::FPruneFunc* PruneFunc = nullptr;
+
+		void AddEntry(FWorker& Worker, const TCHAR* InPath, const bool bIsDirectory, const FFileStatData& InStatData)
+		{
+			FPjcDirectoryEntry Entry;
+			Entry.Path = InPath;
+			Entry.StatData = InStatData;
+
+			if (!bIsDirectory)
+			{
+				Worker.Files.Emplace(MoveTemp(Entry));
+				return;
+			}
+
+			if (PruneFunc && *PruneFunc && (*PruneFunc)(Entry.Path)) return;
+
+			if (bRecursive)
+			{
+				// counter incremented before push, so it cant drop to zero while subdirectory is waiting in queue
+				NumPendingDirs.Increment();
+				Worker.Push(CopyTemp(Entry.Path));
+
+				if (NumIdleWorkers.GetValue() > 0)
+				{
+					WorkEvent->Trigger();
+				}
+			}
+
+			Worker.Folders.Emplace(MoveTemp(Entry));
+		}
+
+		void ListDir(FWorker& Worker, const FString& InDir)
+		{
+			IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+			if (bStat)
+			{
+				PlatformFile.IterateDirectoryStat(*InDir, [&](const TCHAR* InPath, const FFileStatData& InStatData)
+				{
+					AddEntry(Worker, InPath, InStatData.bIsDirectory, InStatData);
+					return true;
+				});
+				return;
+			}
+
+			PlatformFile.IterateDirectory(*InDir, [&](const TCHAR* InPath, const bool bIsDirectory)
+			{
+				AddEntry(Worker, InPath, bIsDirectory, FFileStatData{});
+				return true;
+			});
+		}
+
+		bool Steal(const int32 WorkerIndex, FString& OutDir)
+		{
+			for (int32 Offset = 1; Offset < Workers.Num(); ++Offset)
+			{
+				if (Workers[(WorkerIndex + Offset) % Workers.Num()]->PopFront(OutDir)) return true;
+			}
+
+			return false;
+		}
+
+		void Run(const int32 WorkerIndex)
+		{
+			FWorker& Worker = *Workers[WorkerIndex];
+			FString Dir;
+
+			while (NumPendingDirs.GetValue() > 0)
+			{
+				if (!Worker.PopBack(Dir) && !Steal(WorkerIndex, Dir) && !WaitForWork(WorkerIndex, Dir)) continue;
+
+				ListDir(Worker, Dir);
+
+				if (NumPendingDirs.Decrement() == 0)
+				{
+					// wake idle workers, so they can see walk is finished
+					WorkEvent->Trigger();
+				}
+			}
+		}
+
+		bool WaitForWork(const int32 WorkerIndex, FString& OutDir)
+		{
+			// other workers are still listing directories, that may produce new tasks.
+			// idle counter is raised before queues are checked again, so any push after that check triggers event
+			NumIdleWorkers.Increment();
+			WorkEvent->Reset();
+
+			const bool bFound = NumPendingDirs.GetValue() > 0 && (Workers[WorkerIndex]->PopBack(OutDir) || Steal(WorkerIndex, OutDir));
+			if (!bFound && NumPendingDirs.GetValue() > 0)
+			{
+				WorkEvent->Wait(IdleWaitMs);
+			}
+
+			NumIdleWorkers.Decrement();
+			return bFound;
+		}
+	};
+}
+
+FPjcDirectoryWalker::FPjcDirectoryWalker(const bool bInRecursive, const bool bInStat) : bRecursive(bInRecursive), bStat(bInStat) {}
+
+void FPjcDirectoryWalker::SetPrune(FPruneFunc InPruneFunc)
+{
+	PruneFunc = MoveTemp(InPruneFunc);
+}
+
+void FPjcDirectoryWalker::Walk(const FString& InRootPath, TArray<FPjcDirectoryEntry>& OutFiles, TArray<FPjcDirectoryEntry>& OutFolders) const
+{
+	OutFiles.Reset();
+	OutFolders.Reset();
+
+	FString RootPath = FPaths::ConvertRelativePathToFull(InRootPath);
+	FPaths::NormalizeDirectoryName(RootPath);
+	if (RootPath.IsEmpty()) return;
+
+	const bool bParallel = bRecursive && FApp::ShouldUseThreadingForPerformance();
+	const int32 NumWorkers = bParallel ? FMath::Clamp(FTaskGraphInterface::Get().GetNumWorkerThreads() + 1, 1, PjcDirectoryWalkerLocal::MaxWorkers) : 1;
+
+	PjcDirectoryWalkerLocal::FWalkState State;
+	State.bRecursive = bRecursive;
+	State.bStat = bStat;
+	State.PruneFunc = &PruneFunc;
+	State.WorkEvent = FPlatformProcess::GetSynchEventFromPool(true);
+	State.Workers.Reserve(NumWorkers);
+
+	for (int32 WorkerIndex = 0; WorkerIndex < NumWorkers; ++WorkerIndex)
+	{
+		State.Workers.Emplace(MakeUnique<PjcDirectoryWalkerLocal::FWorker>());
+	}
+
+	State.NumPendingDirs.Set(1);
+	State.Workers[0]->Push(CopyTemp(RootPath));
+
+	// if ParallelFor runs workers one after another, first one simply walks whole tree and others find nothing to do
+	ParallelFor(NumWorkers, [&](const int32 WorkerIndex)
+	{
+		State.Run(WorkerIndex);
+	}, !bParallel);
+
+	FPlatformProcess::ReturnSynchEventToPool(State.WorkEvent);
+	State.WorkEvent = nullptr;
+
+	int32 NumFiles = 0;
+	int32 NumFolders = 0;
+
+	for (const auto& Worker : State.Workers)
+	{
+		NumFiles += Worker->Files.Num();
+		NumFolders += Worker->Folders.Num();
+	}
+
+	OutFiles.Reserve(NumFiles);
+	OutFolders.Reserve(NumFolders);
+
+	for (const auto& Worker : State.Workers)
+	{
+		OutFiles.Append(MoveTemp(Worker->Files));
+		OutFolders.Append(MoveTemp(Worker->Folders));
+	}
+
+	// workers finish in any order, sorting makes result stable and puts every folder before its subfolders
+	const auto SortByPath = [](const FPjcDirectoryEntry& A, const FPjcDirectoryEntry& B)
+	{
+		return A.Path < B.Path;
+	};
+
+	OutFiles.Sort(SortByPath);
+	OutFolders.Sort(SortByPath);
+}
@@ -0,0 +1,313 @@
+﻿// Copyright Ashot Barkhudaryan. All Rights Reserved.
+
+#include "PjcDuplicateFinder.h"
+#include "PjcContentIndex.h"
+#include "PjcPaths.h"
+#include "Pjc.h"
+// Engine Headers
+#include "Async/ParallelFor.h"
+#include "EditorFramework/AssetImportData.h"
+#include "HAL/FileManager.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Misc/SecureHash.h"
+
+namespace PjcDuplicateFinderLocal
+{
+	static constexpr int64 ReadBufferSize = 1024 * 1024;
+	// number of files hashed between progress updates
+	static constexpr int32 BatchSize = 256;
+
+	struct FCachedHash
+	{
+		int64 FileSize = 0;
+		FDateTime FileTime;
+		FSHAHash Hash;
+	};
+
+	struct FPendingHash
+	{
+		int32 FileIndex = INDEX_NONE;
+		FSHAHash Hash;
+		bool bValid = false;
+	};
+
+	static TMap<FString, FCachedHash> CachedHashes;
+
+	static bool GetFileHash(const FString& InFile, TArray<uint8>& Buffer, FSHAHash& OutHash)
+	{
+		const TUniquePtr<FArchive> Reader{IFileManager::Get().CreateFileReader(*InFile, FILEREAD_Silent)};
+		if (!Reader) return false;
+
+		FSHA1 Sha;
+		const int64 Size = Reader->TotalSize();
+
+		for (int64 Offset = 0; Offset < Size;)
+		{
+			const int64 Len = FMath::Min(ReadBufferSize, Size - Offset);
+			Reader->Serialize(Buffer.GetData(), Len);
+			if (Reader->IsError()) return false;
+
+			Sha.Update(Buffer.GetData(), static_cast<uint32>(Len));
+			Offset += Len;
+		}
+
+		Sha.Final();
+		Sha.GetHash(OutHash.Hash);
+
+		return true;
+	}
+
+	// all files of group except biggest one can be removed
+	static void SetGroupSizes(FPjcDuplicateGroup& Group, const TArray<int64>& InSizes)
+	{
+		int64 SizeMax = 0;
+
+		for (const int64 Size : InSizes)
+		{
+			Group.SizeTotal += Size;
+			SizeMax = FMath::Max(SizeMax, Size);
+		}
+
+		Group.SizeReclaimable = Group.SizeTotal - SizeMax;
+	}
+
+	static void SortGroups(TArray<FPjcDuplicateGroup>& Groups)
+	{
+		for (auto& Group : Groups)
+		{
+			Group.Files.Sort();
+		}
+
+		Groups.Sort([](const FPjcDuplicateGroup& A, const FPjcDuplicateGroup& B)
+		{
+			return A.SizeReclaimable != B.SizeReclaimable ? A.SizeReclaimable > B.SizeReclaimable : A.Files[0] < B.Files[0];
+		});
+	}
+}
+
+void FPjcDuplicateFinder::FindFiles(TArray<FPjcDuplicateGroup>& OutGroups, const bool bShowSlowTask)
+{
+	using namespace PjcDuplicateFinderLocal;
+
+	OutGroups.Reset();
+
+	const FPjcContentIndex& ContentIndex = FPjcContentIndex::Get();
+	const TArray<FPjcContentFile>& Files = ContentIndex.GetFiles();
+
+	// hashes of deleted or moved files are dropped, so cache does not grow for whole editor session
+	for (auto It = CachedHashes.CreateIterator(); It; ++It)
+	{
+		if (!ContentIndex.FindFile(It.Key()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// files with unique size can not have duplicates, so they are never read
+	TMap<int64, TArray<int32>> FilesBySize;
+	for (int32 FileIndex = 0; FileIndex < Files.Num(); ++FileIndex)
+	{
+		if (Files[FileIndex].Size <= 0) continue;
+
+		FilesBySize.FindOrAdd(Files[FileIndex].Size).Add(FileIndex);
+	}
+
+	TArray<FSHAHash> Hashes;
+	TArray<bool> HashesValid;
+	Hashes.SetNum(Files.Num());
+	HashesValid.SetNumZeroed(Files.Num());
+
+	TArray<FPendingHash> Pending;
+
+	for (const auto& SizeGroup : FilesBySize)
+	{
+		if (SizeGroup.Value.Num() < 2) continue;
+
+		for (const int32 FileIndex : SizeGroup.Value)
+		{
+			const FPjcContentFile& File = Files[FileIndex];
+			const FCachedHash* CachedHash = CachedHashes.Find(File.Path);
+
+			if (CachedHash && CachedHash->FileSize == File.Size && CachedHash->FileTime == File.Time)
+			{
+				Hashes[FileIndex] = CachedHash->Hash;
+				HashesValid[FileIndex] = true;
+				continue;
+			}
+
+			FPendingHash PendingHash;
+			PendingHash.FileIndex = FileIndex;
+			Pending.Emplace(PendingHash);
+		}
+	}
+
+	FScopedSlowTask SlowTask(
+		static_cast<float>(Pending.Num()),
+		FText::FromString(TEXT("Searching for duplicate files...")),
+		bShowSlowTask && GIsEditor && !IsRunningCommandlet()
+	);
+	SlowTask.MakeDialog(false, false);
+
+	const int32 NumWorkers = FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads() + 1);
+
+	for (int32 BatchStart = 0; BatchStart < Pending.Num(); BatchStart += BatchSize)
+	{
+		const int32 BatchEnd = FMath::Min(BatchStart + BatchSize, Pending.Num());
+
+		SlowTask.EnterProgressFrame(static_cast<float>(BatchEnd - BatchStart));
+
+		// every worker takes next file from shared counter and reuses own read buffer for all its files
+		FThreadSafeCounter NextIndex{BatchStart};
+		ParallelFor(FMath::Min(NumWorkers, BatchEnd - BatchStart), [&](int32)
+		{
+			TArray<uint8> Buffer;
+			Buffer.SetNumUninitialized(ReadBufferSize);
+
+			for (int32 Index = NextIndex.Increment() - 1; Index < BatchEnd; Index = NextIndex.Increment() - 1)
+			{
+				FPendingHash& PendingHash = Pending[Index];
+				PendingHash.bValid = GetFileHash(Files[PendingHash.FileIndex].Path, Buffer, PendingHash.Hash);
+			}
+		});
+
+		for (int32 Index = BatchStart; Index < BatchEnd; ++Index)
+		{
+			const FPendingHash& PendingHash = Pending[Index];
+			if (!PendingHash.bValid) continue;
+
+			const FPjcContentFile& File = Files[PendingHash.FileIndex];
+			Hashes[PendingHash.FileIndex] = PendingHash.Hash;
+			HashesValid[PendingHash.FileIndex] = true;
+
+			FCachedHash CachedHash;
+			CachedHash.FileSize = File.Size;
+			CachedHash.FileTime = File.Time;
+			CachedHash.Hash = PendingHash.Hash;
+			CachedHashes.Emplace(File.Path, CachedHash);
+		}
+	}
+
+	for (const auto& SizeGroup : FilesBySize)
+	{
+		if (SizeGroup.Value.Num() < 2) continue;
+
+		TMap<FSHAHash, TArray<int32>> FilesByHash;
+		for (const int32 FileIndex : SizeGroup.Value)
+		{
+			if (!HashesValid[FileIndex]) continue;
+
+			FilesByHash.FindOrAdd(Hashes[FileIndex]).Add(FileIndex);
+		}
+
+		for (const auto& HashGroup : FilesByHash)
+		{
+			if (HashGroup.Value.Num() < 2) continue;
+
+			FPjcDuplicateGroup Group;
+			Group.Hash = HashGroup.Key.ToString();
+
+			TArray<int64> Sizes;
+			for (const int32 FileIndex : HashGroup.Value)
+			{
+				Group.Files.Add(Files[FileIndex].Path);
+				Sizes.Add(Files[FileIndex].Size);
+			}
+
+			SetGroupSizes(Group, Sizes);
+			OutGroups.Emplace(MoveTemp(Group));
+		}
+	}
+
+	SortGroups(OutGroups);
+}
+
+void FPjcDuplicateFinder::FindAssetsSameSource(const TArray<FAssetData>& InAssets, const TArray<FPjcDuplicateGroup>& InGroupsIdentical, TArray<FPjcDuplicateGroup>& OutGroups)
+{
+	using namespace PjcDuplicateFinderLocal;
+
+	OutGroups.Reset();
+
+	const FPjcContentIndex& ContentIndex = FPjcContentIndex::Get();
+
+	// first file of every byte identical group is kept, all others are already counted as reclaimable there
+	TSet<FString> FilesReclaimed;
+	for (const auto& Group : InGroupsIdentical)
+	{
+		for (int32 FileIndex = 1; FileIndex < Group.Files.Num(); ++FileIndex)
+		{
+			FilesReclaimed.Add(Group.Files[FileIndex]);
+		}
+	}
+
+	// assets are keyed by hashes of all their source files, so multi source assets match only if all sources match
+	TMap<FString, TArray<const FPjcContentFile*>> FilesBySource;
+	TSet<FName> PackagesVisited;
+	TStringBuilder<256> PackagePath;
+
+	for (const auto& Asset : InAssets)
+	{
+		FString ImportDataJson;
+		if (!Asset.GetTagValue(UObject::SourceFileTagName(), ImportDataJson) || ImportDataJson.IsEmpty()) continue;
+
+		const TOptional<FAssetImportInfo> ImportInfo = FAssetImportInfo::FromJson(ImportDataJson);
+		if (!ImportInfo.IsSet() || ImportInfo->SourceFiles.Num() == 0) continue;
+
+		// different asset types imported from same file (like skeletal mesh and its animations) are not duplicates
+		FString SourceKey = Asset.AssetClass.ToString() + TEXT("|");
+		for (const auto& SourceFile : ImportInfo->SourceFiles)
+		{
+			if (!SourceFile.FileHash.IsValid())
+			{
+				SourceKey.Reset();
+				break;
+			}
+
+			SourceKey += LexToString(SourceFile.FileHash);
+		}
+
+		if (SourceKey.IsEmpty()) continue;
+
+		// package can contain several assets from same source, it is counted only once
+		bool bVisited = false;
+		PackagesVisited.Add(Asset.PackageName, &bVisited);
+		if (bVisited) continue;
+
+		if (!FPjcPaths::ToAbsolute(Asset.PackageName.ToString(), PackagePath)) continue;
+
+		PackagePath << TEXT(".uasset");
+		const FPjcContentFile* File = ContentIndex.FindFile(FString{PackagePath.Len(), PackagePath.GetData()});
+
+		if (!File)
+		{
+			PackagePath.RemoveSuffix(6);
+			PackagePath << TEXT("umap");
+			File = ContentIndex.FindFile(FString{PackagePath.Len(), PackagePath.GetData()});
+		}
+
+		if (!File || FilesReclaimed.Contains(File->Path)) continue;
+
+		FilesBySource.FindOrAdd(SourceKey).Add(File);
+	}
+
+	for (const auto& SourceGroup : FilesBySource)
+	{
+		if (SourceGroup.Value.Num() < 2) continue;
+
+		FPjcDuplicateGroup Group;
+		Group.Hash = SourceGroup.Key;
+		Group.bSameSource = true;
+
+		TArray<int64> Sizes;
+		for (const FPjcContentFile* File : SourceGroup.Value)
+		{
+			Group.Files.Add(File->Path);
+			Sizes.Add(File->Size);
+		}
+
+		SetGroupSizes(Group, Sizes);
+		OutGroups.Emplace(MoveTemp(Group));
+	}
+
+	SortGroups(OutGroups);
+}
@@ -417,3 +417,83 @@ FPjcDelegateFilterChanged& FPjcFilterAssetsExtReferenced::OnFilterChanged()
 {
 	return DelegateFilterChanged;
 }
+
+FPjcFilterAssetsDuplicate::FPjcFilterAssetsDuplicate(TSharedPtr<FFrontendFilterCategory> InCategory) : FFrontendFilter(InCategory) {}
+
+FString FPjcFilterAssetsDuplicate::GetName() const
+{
+	return TEXT("Assets Duplicate");
+}
+
+FText FPjcFilterAssetsDuplicate::GetDisplayName() const
+{
+	return FText::FromString(TEXT("Assets Duplicate"));
+}
+
+FText FPjcFilterAssetsDuplicate::GetToolTipText() const
+{
+	return FText::FromString(TEXT("Show assets that are byte identical to other assets or imported from same source files"));
+}
+
+FLinearColor FPjcFilterAssetsDuplicate::GetColor() const
+{
+	return FPjcStyles::Get().GetColor("ProjectCleaner.Color.BlueLight");
+}
+
+void FPjcFilterAssetsDuplicate::ActiveStateChanged(bool bActive)
+{
+	FFrontendFilter::ActiveStateChanged(bActive);
+
+	if (bActive)
+	{
+		UpdateData();
+	}
+
+	if (DelegateFilterChanged.IsBound())
+	{
+		DelegateFilterChanged.Broadcast(bActive);
+	}
+}
+
+bool FPjcFilterAssetsDuplicate::PassesFilter(const FContentBrowserItem& InItem) const
+{
+	FAssetData AssetData;
+	if (!InItem.Legacy_TryGetAssetData(AssetData)) return false;
+
+	return Assets.Contains(AssetData);
+}
+
+void FPjcFilterAssetsDuplicate::UpdateData()
+{
+	Assets.Reset();
+	SizeReclaimable = 0;
+
+	if (UPjcSubsystem::GetModuleAssetRegistry().Get().IsLoadingAssets()) return;
+
+	TArray<FPjcDuplicateGroup> Groups;
+	UPjcSubsystem::GetDuplicateGroups(Groups, true);
+
+	TArray<FAssetData> AssetsDuplicate;
+	UPjcSubsystem::GetAssetsByDuplicateGroups(Groups, AssetsDuplicate);
+	Assets.Append(AssetsDuplicate);
+
+	for (const auto& Group : Groups)
+	{
+		SizeReclaimable += Group.SizeReclaimable;
+	}
+}
+
+const TSet<FAssetData>& FPjcFilterAssetsDuplicate::GetAssets() const
+{
+	return Assets;
+}
+
+int64 FPjcFilterAssetsDuplicate::GetSizeReclaimable() const
+{
+	return SizeReclaimable;
+}
+
+FPjcDelegateFilterChanged& FPjcFilterAssetsDuplicate::OnFilterChanged()
+{
+	return DelegateFilterChanged;
+}
@@ -0,0 +1,218 @@
+﻿// Copyright Ashot Barkhudaryan. All Rights Reserved.
+
+#include "PjcIndirectScanner.h"
+#include "PjcConstants.h"
+// Engine Headers
+#include "Algo/BinarySearch.h"
+#include "HAL/FileManager.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/PackageName.h"
+
+namespace PjcIndirectScannerLocal
+{
+	// must be changed every time any scanner output changes, so cached results are discarded
+	static constexpr int32 ScannersVersion = 2;
+
+	static void EmitCandidates(const uint8* Data, const int64 Size, const TArray<FPjcPathScanMatch>& Matches, TArray<FPjcScanCandidate>& OutCandidates)
+	{
+		if (Matches.Num() == 0) return;
+
+		// offsets of every line start, so line number of any match can be found by binary search
+		TArray<int64> LineStarts;
+		FPjcPathScanner::GetLineStarts(Data, Size, LineStarts);
+
+		OutCandidates.Reserve(OutCandidates.Num() + Matches.Num());
+
+		for (const auto& Match : Matches)
+		{
+			const FUTF8ToTCHAR CandidateConv{reinterpret_cast<const ANSICHAR*>(Data + Match.Offset), Match.Len};
+			const int32 FileLine = Algo::UpperBound(LineStarts, Match.Offset);
+
+			OutCandidates.Emplace(FPjcScanCandidate{FString{CandidateConv.Length(), CandidateConv.Get()}, FileLine});
+		}
+	}
+}
+
+FPjcIndirectScannerText::FPjcIndirectScannerText(const TArray<FString>& InExtensions, const TArray<FString>& InPrefixes)
+	: Extensions(InExtensions), PathScanner(InPrefixes) {}
+
+TArray<FString> FPjcIndirectScannerText::GetExtensions() const
+{
+	return Extensions;
+}
+
+void FPjcIndirectScannerText::Scan(const uint8* Data, const int64 Size, TArray<FPjcScanCandidate>& OutCandidates) const
+{
+	TArray<FPjcPathScanMatch> Matches;
+	PathScanner.Scan(Data, Size, Matches);
+
+	PjcIndirectScannerLocal::EmitCandidates(Data, Size, Matches, OutCandidates);
+}
+
+FPjcIndirectScannerJson::FPjcIndirectScannerJson(const TArray<FString>& InExtensions, const TArray<FString>& InPrefixes)
+	: FPjcIndirectScannerText(InExtensions, InPrefixes) {}
+
+void FPjcIndirectScannerJson::Scan(const uint8* Data, const int64 Size, TArray<FPjcScanCandidate>& OutCandidates) const
+{
+	// most json files have no escaped slashes, those are scanned in place
+	const uint8* End = Data + Size;
+	const uint8* Escape = FPjcPathScanner::FindByte(Data, End, '\\');
+
+	while (Escape != End && !(Escape + 1 < End && *(Escape + 1) == '/'))
+	{
+		Escape = FPjcPathScanner::FindByte(Escape + 1, End, '\\');
+	}
+
+	if (Escape == End)
+	{
+		FPjcIndirectScannerText::Scan(Data, Size, OutCandidates);
+		return;
+	}
+
+	// otherwise \/ sequences are unescaped into copy, line breaks are kept, so line numbers stay same
+	TArray<uint8> Unescaped;
+	Unescaped.Reserve(Size);
+	Unescaped.Append(Data, Escape - Data);
+
+	for (const uint8* Cur = Escape; Cur < End; ++Cur)
+	{
+		if (*Cur == '\\' && Cur + 1 < End && *(Cur + 1) == '/')
+		{
+			continue;
+		}
+
+		Unescaped.Add(*Cur);
+	}
+
+	FPjcIndirectScannerText::Scan(Unescaped.GetData(), Unescaped.Num(), OutCandidates);
+}
+
+FPjcConfigScanner::FPjcConfigScanner(const TArray<FString>& InPrefixes) : PathScanner(InPrefixes) {}
+
+void FPjcConfigScanner::Scan(const FPjcScanCache& InCache, TArray<FPjcScanConfigEntry>& OutEntries) const
+{
+	OutEntries.Reset();
+
+	if (!GConfig) return;
+
+	TArray<FString> BranchPaths;
+	GConfig->GetConfigFilenames(BranchPaths);
+	BranchPaths.Sort();
+
+	const FString DirCfg = FPaths::ConvertRelativePathToFull(FPaths::ProjectConfigDir());
+	const FString DirPlg = FPaths::ConvertRelativePathToFull(FPaths::ProjectPluginsDir());
+
+	OutEntries.Reserve(BranchPaths.Num());
+
+	for (const auto& BranchPath : BranchPaths)
+	{
+		const FConfigFile* ConfigFile = GConfig->FindConfigFile(BranchPath);
+		if (!ConfigFile) continue;
+
+		FPjcScanConfigEntry Entry;
+		Entry.BranchPath = FPaths::ConvertRelativePathToFull(BranchPath);
+
+		// hierarchy is hashed by file stats, so branch is walked again only if any of its ini files changed
+		FString HierarchyStat;
+		for (const auto& Ini : ConfigFile->SourceIniHierarchy)
+		{
+			const FString IniPath = FPaths::ConvertRelativePathToFull(Ini.Value.Filename);
+			const FFileStatData StatData = IFileManager::Get().GetStatData(*IniPath);
+			if (!StatData.bIsValid) continue;
+
+			HierarchyStat += FString::Printf(TEXT("%s|%lld|%lld;"), *IniPath, StatData.FileSize, StatData.ModificationTime.GetTicks());
+
+			// only project and plugin inis are owned by project, engine inis and per user Saved/Config layer are not
+			const bool bIsProjectIni = FPaths::IsUnderDirectory(IniPath, DirCfg);
+			const bool bIsPluginIni = FPaths::IsUnderDirectory(IniPath, DirPlg) && IniPath.Contains(TEXT("/Config/"));
+			if (!bIsProjectIni && !bIsPluginIni) continue;
+
+			Entry.HierarchyFiles.Add(IniPath);
+		}
+
+		if (Entry.HierarchyFiles.Num() == 0) continue;
+
+		const FTCHARToUTF8 HierarchyStatUtf8{*HierarchyStat};
+		Entry.HierarchyHash = FPjcScanCache::GetHash(reinterpret_cast<const uint8*>(HierarchyStatUtf8.Get()), HierarchyStatUtf8.Length());
+
+		// dirty branches have values changed in memory, that are not saved yet
+		const FPjcScanConfigEntry* CachedEntry = InCache.FindConfig(Entry.BranchPath);
+		if (CachedEntry && !ConfigFile->Dirty && CachedEntry->HierarchyHash == Entry.HierarchyHash)
+		{
+			Entry.Candidates = CachedEntry->Candidates;
+			OutEntries.Emplace(MoveTemp(Entry));
+			continue;
+		}
+
+		TSet<FString> Candidates;
+		TArray<FPjcPathScanMatch> Matches;
+
+		for (const auto& Section : *ConfigFile)
+		{
+			for (const auto& Value : Section.Value)
+			{
+				const FTCHARToUTF8 ValueUtf8{*Value.Value.GetValue()};
+				const uint8* ValueData = reinterpret_cast<const uint8*>(ValueUtf8.Get());
+
+				Matches.Reset();
+				PathScanner.Scan(ValueData, ValueUtf8.Length(), Matches);
+
+				for (const auto& Match : Matches)
+				{
+					const FUTF8ToTCHAR CandidateConv{reinterpret_cast<const ANSICHAR*>(ValueData + Match.Offset), Match.Len};
+					Candidates.Add(FString{CandidateConv.Length(), CandidateConv.Get()});
+				}
+			}
+		}
+
+		Entry.Candidates = Candidates.Array();
+		Entry.Candidates.Sort();
+		OutEntries.Emplace(MoveTemp(Entry));
+	}
+}
+
+FPjcIndirectScanners::FPjcIndirectScanners(const TArray<FString>& InPrefixes) : Prefixes(InPrefixes)
+{
+	TArray<FString> TextExtensions;
+	TextExtensions.Append(PjcConstants::SourceFileExtensions.Array());
+	TextExtensions.Append(PjcConstants::ConfigFileExtensions.Array());
+	TextExtensions.Append(PjcConstants::ScriptFileExtensions.Array());
+	TextExtensions.Add(TEXT("csv"));
+
+	Register(MakeShared<FPjcIndirectScannerText>(TextExtensions, Prefixes));
+	Register(MakeShared<FPjcIndirectScannerJson>(TArray<FString>{TEXT("json"), TEXT("uproject"), TEXT("uplugin")}, Prefixes));
+}
+
+void FPjcIndirectScanners::Register(const TSharedRef<IPjcIndirectScanner>& InScanner)
+{
+	for (const auto& Ext : InScanner->GetExtensions())
+	{
+		ScannersByExt.Add(Ext.ToLower(), InScanner);
+	}
+}
+
+const IPjcIndirectScanner* FPjcIndirectScanners::Find(const FString& InFilePath) const
+{
+	const TSharedRef<IPjcIndirectScanner>* Scanner = ScannersByExt.Find(FPaths::GetExtension(InFilePath).ToLower());
+
+	return Scanner ? &Scanner->Get() : nullptr;
+}
+
+FString FPjcIndirectScanners::GetKey() const
+{
+	TArray<FString> Extensions;
+	ScannersByExt.GetKeys(Extensions);
+	Extensions.Sort();
+
+	return FString::Printf(TEXT("%d|%s|%s"), PjcIndirectScannerLocal::ScannersVersion, *FString::Join(Prefixes, TEXT(",")), *FString::Join(Extensions, TEXT(",")));
+}
+
+TArray<FString> FPjcIndirectScanners::GetMountPrefixes()
+{
+	TArray<FString> Prefixes;
+	FPackageName::QueryRootContentPaths(Prefixes);
+
+	Prefixes.Sort();
+
+	return Prefixes;
+}
@@ -0,0 +1,260 @@
+﻿// Copyright Ashot Barkhudaryan. All Rights Reserved.
+
+#include "PjcPackageValidator.h"
+#include "PjcContentIndex.h"
+#include "Pjc.h"
+// Engine Headers
+#include "Async/AsyncFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Serialization/MemoryReader.h"
+#include "UObject/PackageFileSummary.h"
+
+namespace PjcPackageValidatorLocal
+{
+	// number of packages read at same time
+	static constexpr int32 NumInFlight = 64;
+	// package summary usually takes few kilobytes, bigger summaries are read synchronously
+	static constexpr int64 SummaryReadSize = 64 * 1024;
+	static constexpr int64 TagSize = sizeof(uint32);
+
+	struct FCachedResult
+	{
+		int64 FileSize = 0;
+		FDateTime FileTime;
+		int64 ExpSize = 0;
+		int64 BulkSize = 0;
+		FString Error;
+	};
+
+	struct FPendingRead
+	{
+		FString File;
+		int64 FileSize = 0;
+		FDateTime FileTime;
+		int64 ExpSize = INDEX_NONE;
+		int64 BulkSize = INDEX_NONE;
+
+		// requests must be destroyed before their handles, so declared after them
+		TUniquePtr<IAsyncReadFileHandle> Handle;
+		TUniquePtr<IAsyncReadFileHandle> TailHandle;
+		TUniquePtr<IAsyncReadRequest> SummaryRequest;
+		TUniquePtr<IAsyncReadRequest> TailRequest;
+	};
+
+	static TMap<FString, FCachedResult> CachedResults;
+
+	static bool IsPackageTag(const uint32 Tag)
+	{
+		return Tag == PACKAGE_FILE_TAG || Tag == PACKAGE_FILE_TAG_SWAPPED;
+	}
+
+	static TArray<uint8> GetReadResults(IAsyncReadRequest* Request, const int64 Size)
+	{
+		TArray<uint8> Data;
+		if (!Request) return Data;
+
+		Request->WaitCompletion();
+
+		uint8* Results = Request->GetReadResults();
+		if (!Results) return Data;
+
+		Data.Append(Results, static_cast<int32>(Size));
+		FMemory::Free(Results);
+
+		return Data;
+	}
+
+	static FString GetSummaryError(const FPackageFileSummary& Summary, const FPendingRead& Read)
+	{
+		if (!IsPackageTag(Summary.Tag)) return TEXT("invalid package tag");
+
+		if (Summary.GetFileVersionUE4() > GPackageFileUE4Version || Summary.GetFileVersionLicenseeUE4() > GPackageFileLicenseeUE4Version)
+		{
+			return TEXT("saved by newer engine version");
+		}
+
+		if (!Summary.bUnversioned && Summary.GetFileVersionUE4() < VER_UE4_OLDEST_LOADABLE_PACKAGE)
+		{
+			return TEXT("saved by unsupported engine version");
+		}
+
+		if (Summary.TotalHeaderSize <= 0 || Summary.TotalHeaderSize > Read.FileSize) return TEXT("header is bigger than file");
+
+		// exports are stored right after header, either in same file or in .uexp file for split packages
+		const bool bHasExp = Read.ExpSize != INDEX_NONE;
+		const int64 PackageSize = Read.FileSize + (bHasExp ? Read.ExpSize : 0);
+
+		if (!bHasExp && Summary.ExportCount > 0 && Summary.TotalHeaderSize == Read.FileSize) return TEXT("missing .uexp file");
+		if (!bHasExp && Read.BulkSize != INDEX_NONE) return TEXT(".ubulk file without .uexp file");
+
+		// inline bulk data lies between bulk data offset and package tag, offsets into .ubulk file are relative to same bulk data offset
+		const bool bHasBulk = Read.BulkSize != INDEX_NONE;
+		if (Summary.BulkDataStartOffset > 0 && Summary.BulkDataStartOffset < Summary.TotalHeaderSize) return TEXT("bulk data offset is inside of header");
+		if (Summary.BulkDataStartOffset > PackageSize - TagSize) return TEXT("file is smaller than package data");
+		if (bHasBulk && Read.BulkSize == 0) return TEXT(".ubulk file is empty");
+		if (bHasBulk && Summary.BulkDataStartOffset <= 0) return TEXT(".ubulk file, but package has no bulk data offset");
+
+		return {};
+	}
+
+	static FString GetError(FPendingRead& Read)
+	{
+		if (Read.FileSize < TagSize * 2) return TEXT("file is truncated");
+		if (!Read.Handle || !Read.TailHandle) return TEXT("file can not be read");
+
+		const int64 SummarySize = FMath::Min(SummaryReadSize, Read.FileSize);
+		const TArray<uint8> SummaryData = GetReadResults(Read.SummaryRequest.Get(), SummarySize);
+		const TArray<uint8> TailData = GetReadResults(Read.TailRequest.Get(), TagSize);
+
+		if (SummaryData.Num() == 0 || TailData.Num() == 0) return TEXT("file can not be read");
+
+		// package files always end with package tag, truncated files dont
+		uint32 TailTag = 0;
+		FMemory::Memcpy(&TailTag, TailData.GetData(), TagSize);
+		if (!IsPackageTag(TailTag)) return TEXT("file is truncated");
+
+		FPackageFileSummary Summary;
+		FMemoryReader SummaryReader{SummaryData};
+		SummaryReader << Summary;
+
+		if (SummaryReader.IsError() && SummarySize < Read.FileSize)
+		{
+			Summary = FPackageFileSummary{};
+
+			const TUniquePtr<FArchive> FileReader{IFileManager::Get().CreateFileReader(*Read.File, FILEREAD_Silent)};
+			if (!FileReader) return TEXT("file can not be read");
+
+			*FileReader << Summary;
+			if (FileReader->IsError()) return TEXT("invalid package summary");
+		}
+		else if (SummaryReader.IsError())
+		{
+			return TEXT("invalid package summary");
+		}
+
+		return GetSummaryError(Summary, Read);
+	}
+}
+
+void FPjcPackageValidator::Validate(const TArray<FString>& InFiles, TArray<FString>& OutInvalidFiles, const bool bShowSlowTask)
+{
+	using namespace PjcPackageValidatorLocal;
+
+	OutInvalidFiles.Reset();
+
+	const FPjcContentIndex& ContentIndex = FPjcContentIndex::Get();
+
+	// results of deleted or moved packages are dropped, so cache does not grow for whole editor session
+	for (auto It = CachedResults.CreateIterator(); It; ++It)
+	{
+		if (!ContentIndex.FindFile(It.Key()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	const auto GetSiblingSize = [&](const FString& InFile, const TCHAR* InExt)
+	{
+		const FPjcContentFile* Sibling = ContentIndex.FindFile(FPaths::ChangeExtension(InFile, InExt));
+		return Sibling ? Sibling->Size : static_cast<int64>(INDEX_NONE);
+	};
+
+	// only new or changed packages are read
+	TArray<FPendingRead> Reads;
+	Reads.Reserve(InFiles.Num());
+
+	for (const auto& File : InFiles)
+	{
+		const FPjcContentFile* ContentFile = ContentIndex.FindFile(File);
+		if (!ContentFile) continue;
+
+		FPendingRead Read;
+		Read.File = File;
+		Read.FileSize = ContentFile->Size;
+		Read.FileTime = ContentFile->Time;
+		Read.ExpSize = GetSiblingSize(File, TEXT(".uexp"));
+		Read.BulkSize = GetSiblingSize(File, TEXT(".ubulk"));
+
+		const FCachedResult* CachedResult = CachedResults.Find(File);
+		if (
+			CachedResult &&
+			CachedResult->FileSize == Read.FileSize &&
+			CachedResult->FileTime == Read.FileTime &&
+			CachedResult->ExpSize == Read.ExpSize &&
+			CachedResult->BulkSize == Read.BulkSize
+		)
+		{
+			if (!CachedResult->Error.IsEmpty())
+			{
+				OutInvalidFiles.Emplace(File);
+			}
+
+			continue;
+		}
+
+		Reads.Emplace(MoveTemp(Read));
+	}
+
+	FScopedSlowTask SlowTask(
+		static_cast<float>(Reads.Num()),
+		FText::FromString(TEXT("Validating package files...")),
+		bShowSlowTask && GIsEditor && !IsRunningCommandlet()
+	);
+	SlowTask.MakeDialog(false, false);
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	for (int32 BatchStart = 0; BatchStart < Reads.Num(); BatchStart += NumInFlight)
+	{
+		const int32 BatchEnd = FMath::Min(BatchStart + NumInFlight, Reads.Num());
+
+		SlowTask.EnterProgressFrame(static_cast<float>(BatchEnd - BatchStart));
+
+		// all reads of batch are issued before waiting for any of them, so IO system processes them in parallel
+		for (int32 Index = BatchStart; Index < BatchEnd; ++Index)
+		{
+			FPendingRead& Read = Reads[Index];
+			if (Read.FileSize < TagSize * 2) continue;
+
+			// package tag is at the end of .uexp file for split packages
+			const bool bHasExp = Read.ExpSize >= TagSize;
+			const FString TailFile = bHasExp ? FPaths::ChangeExtension(Read.File, TEXT(".uexp")) : Read.File;
+			const int64 TailSize = bHasExp ? Read.ExpSize : Read.FileSize;
+
+			Read.Handle.Reset(PlatformFile.OpenAsyncRead(*Read.File));
+			Read.TailHandle.Reset(PlatformFile.OpenAsyncRead(*TailFile));
+
+			if (!Read.Handle || !Read.TailHandle) continue;
+
+			Read.SummaryRequest.Reset(Read.Handle->ReadRequest(0, FMath::Min(SummaryReadSize, Read.FileSize)));
+			Read.TailRequest.Reset(Read.TailHandle->ReadRequest(TailSize - TagSize, TagSize));
+		}
+
+		for (int32 Index = BatchStart; Index < BatchEnd; ++Index)
+		{
+			FPendingRead& Read = Reads[Index];
+
+			FCachedResult Result;
+			Result.FileSize = Read.FileSize;
+			Result.FileTime = Read.FileTime;
+			Result.ExpSize = Read.ExpSize;
+			Result.BulkSize = Read.BulkSize;
+			Result.Error = GetError(Read);
+
+			Read.SummaryRequest.Reset();
+			Read.TailRequest.Reset();
+			Read.Handle.Reset();
+			Read.TailHandle.Reset();
+
+			if (!Result.Error.IsEmpty())
+			{
+				UE_LOG(LogProjectCleaner, Warning, TEXT("Suspect package %s: %s"), *Read.File, *Result.Error);
+				OutInvalidFiles.Emplace(Read.File);
+			}
+
+			CachedResults.Emplace(Read.File, MoveTemp(Result));
+		}
+	}
+}
@@ -0,0 +1,321 @@
+﻿// Copyright Ashot Barkhudaryan. All Rights Reserved.
+
+#include "PjcPathScanner.h"
+// Engine Headers
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/FileHelper.h"
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY
+#define PJC_SCANNER_SSE2 1
+#include <emmintrin.h>
+#if defined(__AVX2__)
+#define PJC_SCANNER_AVX2 1
+#include <immintrin.h>
+#else
+#define PJC_SCANNER_AVX2 0
+#endif
+#else
+#define PJC_SCANNER_SSE2 0
+#define PJC_SCANNER_AVX2 0
+#endif
+
+namespace PjcPathScannerLocal
+{
+	enum ECharFlags : uint8
+	{
+		None = 0,
+		Path = 1 << 0, // [A-Za-z0-9_./]
+		Word = 1 << 1, // [A-Za-z0-9_]
+	};
+
+	struct FCharTable
+	{
+		uint8 Flags[256];
+
+		FCharTable()
+		{
+			FMemory::Memzero(Flags);
+
+			for (uint8 Char = 'a'; Char <= 'z'; ++Char) Flags[Char] = Path | Word;
+			for (uint8 Char = 'A'; Char <= 'Z'; ++Char) Flags[Char] = Path | Word;
+			for (uint8 Char = '0'; Char <= '9'; ++Char) Flags[Char] = Path | Word;
+
+			Flags['_'] = Path | Word;
+			Flags['.'] = Path;
+			Flags['/'] = Path;
+		}
+	};
+
+	static const FCharTable CharTable;
+}
+
+FPjcPathScanner::FPjcPathScanner(const TArray<FString>& InPrefixes)
+{
+	constexpr int32 NumBytes = 256;
+
+	// building trie first, missing transitions are marked with INDEX_NONE
+	Transitions.Init(INDEX_NONE, NumBytes);
+	MatchLens.Init(0, 1);
+
+	for (const auto& Prefix : InPrefixes)
+	{
+		// scanning is driven by searching '/' bytes, so every prefix must start with it
+		if (!Prefix.StartsWith(TEXT("/"))) continue;
+
+		const FTCHARToUTF8 PrefixUtf8{*Prefix};
+		const uint8* PrefixBytes = reinterpret_cast<const uint8*>(PrefixUtf8.Get());
+
+		int32 State = 0;
+		for (int32 i = 0; i < PrefixUtf8.Length(); ++i)
+		{
+			const int32 TransitionIndex = State * NumBytes + PrefixBytes[i];
+			if (Transitions[TransitionIndex] == INDEX_NONE)
+			{
+				Transitions[TransitionIndex] = MatchLens.Num();
+				Transitions.AddUninitialized(NumBytes);
+				FMemory::Memset(Transitions.GetData() + Transitions[TransitionIndex] * NumBytes, 0xFF, NumBytes * sizeof(int32)); // INDEX_NONE
+				MatchLens.Add(0);
+			}
+
+			State = Transitions[TransitionIndex];
+		}
+
+		MatchLens[State] = PrefixUtf8.Length();
+	}
+
+	// converting trie to automaton, by resolving failure links in breadth first order
+	TArray<int32> FailLinks;
+	FailLinks.Init(0, MatchLens.Num());
+
+	TArray<int32> Queue;
+	Queue.Reserve(MatchLens.Num());
+
+	for (int32 Byte = 0; Byte < NumBytes; ++Byte)
+	{
+		int32& Next = Transitions[Byte];
+		if (Next == INDEX_NONE)
+		{
+			Next = 0;
+		}
+		else
+		{
+			FailLinks[Next] = 0;
+			Queue.Add(Next);
+		}
+	}
+
+	for (int32 QueueIndex = 0; QueueIndex < Queue.Num(); ++QueueIndex)
+	{
+		const int32 State = Queue[QueueIndex];
+
+		if (MatchLens[State] == 0)
+		{
+			MatchLens[State] = MatchLens[FailLinks[State]];
+		}
+
+		for (int32 Byte = 0; Byte < NumBytes; ++Byte)
+		{
+			int32& Next = Transitions[State * NumBytes + Byte];
+			const int32 FailNext = Transitions[FailLinks[State] * NumBytes + Byte];
+
+			if (Next == INDEX_NONE)
+			{
+				Next = FailNext;
+			}
+			else
+			{
+				FailLinks[Next] = FailNext;
+				Queue.Add(Next);
+			}
+		}
+	}
+}
+
+void FPjcPathScanner::Scan(const uint8* Data, const int64 Size, TArray<FPjcPathScanMatch>& OutMatches) const
+{
+	if (!Data || Size <= 0 || MatchLens.Num() <= 1) return;
+
+	const uint8* End = Data + Size;
+	const uint8* Cur = Data;
+	int32 State = 0;
+
+	while (Cur < End)
+	{
+		// all prefixes start with '/', so in root state we can skip directly to next one
+		if (State == 0)
+		{
+			Cur = FindByte(Cur, End, '/');
+			if (Cur == End) break;
+		}
+
+		State = Transitions[State * 256 + *Cur];
+		++Cur;
+
+		const int32 PrefixLen = MatchLens[State];
+		if (PrefixLen == 0) continue;
+
+		// greedily consume path characters, then step back to last word character, so match ends on word boundary
+		const uint8* MatchBegin = Cur - PrefixLen;
+		const uint8* PathEnd = Cur;
+
+		while (PathEnd < End && IsPathChar(*PathEnd))
+		{
+			++PathEnd;
+		}
+
+		while (PathEnd > Cur && !IsWordChar(*(PathEnd - 1)))
+		{
+			--PathEnd;
+		}
+
+		if (PathEnd > Cur)
+		{
+			OutMatches.Emplace(FPjcPathScanMatch{MatchBegin - Data, static_cast<int32>(PathEnd - MatchBegin)});
+			Cur = PathEnd;
+			State = 0;
+		}
+	}
+}
+
+const uint8* FPjcPathScanner::FindByte(const uint8* Begin, const uint8* End, const uint8 Byte)
+{
+	const uint8* Cur = Begin;
+
+#if PJC_SCANNER_AVX2
+	const __m256i Needle256 = _mm256_set1_epi8(static_cast<char>(Byte));
+	while (End - Cur >= 32)
+	{
+		const __m256i Chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Cur));
+		const uint32 Mask = static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(Chunk, Needle256)));
+		if (Mask != 0)
+		{
+			return Cur + FMath::CountTrailingZeros(Mask);
+		}
+		Cur += 32;
+	}
+#endif
+
+#if PJC_SCANNER_SSE2
+	const __m128i Needle128 = _mm_set1_epi8(static_cast<char>(Byte));
+	while (End - Cur >= 16)
+	{
+		const __m128i Chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Cur));
+		const uint32 Mask = static_cast<uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(Chunk, Needle128)));
+		if (Mask != 0)
+		{
+			return Cur + FMath::CountTrailingZeros(Mask);
+		}
+		Cur += 16;
+	}
+#endif
+
+	while (Cur < End)
+	{
+		if (*Cur == Byte) return Cur;
+		++Cur;
+	}
+
+	return End;
+}
+
+void FPjcPathScanner::GetLineStarts(const uint8* Data, const int64 Size, TArray<int64>& OutLineStarts)
+{
+	OutLineStarts.Reset();
+	OutLineStarts.Add(0);
+
+	if (!Data || Size <= 0) return;
+
+	const uint8* End = Data + Size;
+	const uint8* Cur = FindByte(Data, End, '\n');
+
+	while (Cur != End)
+	{
+		OutLineStarts.Add(Cur - Data + 1);
+		Cur = FindByte(Cur + 1, End, '\n');
+	}
+}
+
+bool FPjcPathScanner::IsUtf16(const uint8* Data, const int64 Size)
+{
+	if (!Data || Size < 2) return false;
+
+	return (Data[0] == 0xFF && Data[1] == 0xFE) || (Data[0] == 0xFE && Data[1] == 0xFF);
+}
+
+bool FPjcPathScanner::IsPathChar(const uint8 Char)
+{
+	return (PjcPathScannerLocal::CharTable.Flags[Char] & PjcPathScannerLocal::Path) != 0;
+}
+
+bool FPjcPathScanner::IsWordChar(const uint8 Char)
+{
+	return (PjcPathScannerLocal::CharTable.Flags[Char] & PjcPathScannerLocal::Word) != 0;
+}
+
+FPjcScanFile::~FPjcScanFile()
+{
+	Close();
+}
+
+bool FPjcScanFile::Open(const FString& InFilePath)
+{
+	Close();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	MappedHandle = PlatformFile.OpenMapped(*InFilePath);
+	if (MappedHandle && MappedHandle->GetFileSize() > 0)
+	{
+		MappedRegion = MappedHandle->MapRegion(0, MappedHandle->GetFileSize());
+	}
+
+	if (!MappedRegion)
+	{
+		delete MappedHandle;
+		MappedHandle = nullptr;
+
+		if (!FFileHelper::LoadFileToArray(Buffer, *InFilePath, FILEREAD_Silent)) return false;
+	}
+
+	if (GetSize() <= 0)
+	{
+		Close();
+		return false;
+	}
+
+	if (FPjcPathScanner::IsUtf16(GetData(), GetSize()))
+	{
+		FString ContentStr;
+		FFileHelper::BufferToString(ContentStr, GetData(), GetSize());
+
+		const FTCHARToUTF8 ContentUtf8{*ContentStr};
+		TArray<uint8> ContentBytes{reinterpret_cast<const uint8*>(ContentUtf8.Get()), ContentUtf8.Length()};
+
+		Close();
+		Buffer = MoveTemp(ContentBytes);
+	}
+
+	return GetSize() > 0;
+}
+
+void FPjcScanFile::Close()
+{
+	delete MappedRegion;
+	MappedRegion = nullptr;
+
+	delete MappedHandle;
+	MappedHandle = nullptr;
+
+	Buffer.Empty();
+}
+
+const uint8* FPjcScanFile::GetData() const
+{
+	return MappedRegion ? MappedRegion->GetMappedPtr() : Buffer.GetData();
+}
+
+int64 FPjcScanFile::GetSize() const
+{
+	return MappedRegion ? MappedRegion->GetMappedSize() : Buffer.Num();
+}
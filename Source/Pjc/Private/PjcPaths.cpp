@@ -0,0 +1,288 @@
+﻿// Copyright Ashot Barkhudaryan. All Rights Reserved.
+
+#include "PjcPaths.h"
+#include "PjcConstants.h"
+
+namespace PjcPathsLocal
+{
+	struct FMountPoint
+	{
+		FString ContentRoot;
+		FString ContentDir;
+
+		FMountPoint()
+		{
+			ContentRoot = PjcConstants::PathRoot.ToString();
+			ContentDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir());
+			ContentDir.RemoveFromEnd(TEXT("/"));
+		}
+	};
+
+	static const FMountPoint& GetMountPoint()
+	{
+		static const FMountPoint MountPoint;
+		return MountPoint;
+	}
+
+	static bool IsSlash(const TCHAR Char)
+	{
+		return Char == TEXT('/') || Char == TEXT('\\');
+	}
+
+	// true if path starts with given prefix, followed by slash or nothing
+	static bool StartsWithDir(const FStringView InPath, const FStringView InDir)
+	{
+		return InPath.StartsWith(InDir) && (InPath.Len() == InDir.Len() || IsSlash(InPath[InDir.Len()]));
+	}
+
+	static FStringView TrimSlashEnd(FStringView InPath)
+	{
+		while (InPath.Len() > 0 && IsSlash(InPath[InPath.Len() - 1]))
+		{
+			InPath = InPath.LeftChop(1);
+		}
+
+		return InPath;
+	}
+
+	// Class'/Game/Folder/Asset.Asset_C' => /Game/Folder/Asset.Asset, same as FPackageName::ExportTextPathToObjectPath
+	static FStringView ExportTextStrip(FStringView InPath)
+	{
+		int32 QuoteIndex = INDEX_NONE;
+		if (InPath.FindChar(TEXT('\''), QuoteIndex))
+		{
+			InPath = InPath.RightChop(QuoteIndex + 1);
+
+			if (InPath.EndsWith(TEXT("'")))
+			{
+				InPath = InPath.LeftChop(1);
+			}
+		}
+
+		// blueprint generated class suffix
+		if (InPath.EndsWith(TEXT("_C")))
+		{
+			InPath = InPath.LeftChop(2);
+		}
+
+		return InPath;
+	}
+
+	// asset object path always ends with Name.Name
+	static bool IsObjectPath(const FStringView InPath)
+	{
+		FStringView AssetName = TrimSlashEnd(InPath);
+
+		int32 SlashIndex = INDEX_NONE;
+		if (AssetName.FindLastChar(TEXT('/'), SlashIndex))
+		{
+			AssetName = AssetName.RightChop(SlashIndex + 1);
+		}
+
+		int32 DotIndex = INDEX_NONE;
+		if (!AssetName.FindChar(TEXT('.'), DotIndex)) return false;
+
+		const FStringView Left = AssetName.Left(DotIndex);
+		const FStringView Right = AssetName.RightChop(DotIndex + 1);
+
+		return Left.Len() > 0 && Right.Len() > 0 && Left.Equals(Right, ESearchCase::CaseSensitive);
+	}
+
+	static void AppendRebased(const FStringView InPath, const FStringView InFrom, const FStringView InTo, FStringBuilderBase& OutPath)
+	{
+		OutPath.Reset();
+		OutPath << InTo << InPath.RightChop(InFrom.Len());
+	}
+}
+
+bool FPjcPaths::Normalize(FStringView InPath, FStringBuilderBase& OutPath)
+{
+	OutPath.Reset();
+
+	// only absolute or /Game paths can be normalized
+	const bool bHasDrive = InPath.Len() > 2 && InPath[1] == TEXT(':');
+	if (InPath.Len() == 0 || !(PjcPathsLocal::IsSlash(InPath[0]) || bHasDrive)) return false;
+
+	InPath = InPath.TrimStartAndEnd();
+
+	int32 Pos = 0;
+	if (bHasDrive)
+	{
+		OutPath << InPath[0] << TEXT(':');
+		Pos = 2;
+	}
+
+	const int32 RootLen = OutPath.Len();
+	int32 NumCollapsible = 0;
+
+	while (Pos < InPath.Len())
+	{
+		while (Pos < InPath.Len() && PjcPathsLocal::IsSlash(InPath[Pos]))
+		{
+			++Pos;
+		}
+
+		const int32 SegmentStart = Pos;
+		while (Pos < InPath.Len() && !PjcPathsLocal::IsSlash(InPath[Pos]))
+		{
+			++Pos;
+		}
+
+		const FStringView Segment = InPath.Mid(SegmentStart, Pos - SegmentStart);
+		if (Segment.Len() == 0 || Segment.Equals(TEXT("."))) continue;
+
+		// ".." removes previous segment, if there is nothing to remove its kept as is
+		if (Segment.Equals(TEXT("..")) && NumCollapsible > 0)
+		{
+			int32 Len = OutPath.Len();
+			while (Len > RootLen && OutPath.GetData()[Len - 1] != TEXT('/'))
+			{
+				--Len;
+			}
+
+			OutPath.RemoveSuffix(OutPath.Len() - Len + 1);
+			--NumCollapsible;
+			continue;
+		}
+
+		if (!Segment.Equals(TEXT("..")))
+		{
+			++NumCollapsible;
+		}
+
+		OutPath << TEXT('/') << Segment;
+	}
+
+	// root itself is not valid path
+	if (OutPath.Len() == RootLen && !bHasDrive) return false;
+
+	return true;
+}
+
+bool FPjcPaths::ToAbsolute(FStringView InPath, FStringBuilderBase& OutPath)
+{
+	TStringBuilder<256> PathNormalized;
+	if (!Normalize(InPath, PathNormalized))
+	{
+		OutPath.Reset();
+		return false;
+	}
+
+	const FStringView Path = PathNormalized.ToView();
+
+	if (PjcPathsLocal::StartsWithDir(Path, GetContentDir()))
+	{
+		OutPath.Reset();
+		OutPath << Path;
+		return true;
+	}
+
+	if (PjcPathsLocal::StartsWithDir(Path, GetContentRoot()))
+	{
+		PjcPathsLocal::AppendRebased(Path, GetContentRoot(), GetContentDir(), OutPath);
+		return true;
+	}
+
+	OutPath.Reset();
+	return false;
+}
+
+bool FPjcPaths::ToRelative(FStringView InPath, FStringBuilderBase& OutPath)
+{
+	TStringBuilder<256> PathNormalized;
+	if (!Normalize(InPath, PathNormalized))
+	{
+		OutPath.Reset();
+		return false;
+	}
+
+	const FStringView Path = PathNormalized.ToView();
+
+	if (PjcPathsLocal::StartsWithDir(Path, GetContentRoot()))
+	{
+		OutPath.Reset();
+		OutPath << Path;
+		return true;
+	}
+
+	if (PjcPathsLocal::StartsWithDir(Path, GetContentDir()))
+	{
+		PjcPathsLocal::AppendRebased(Path, GetContentDir(), GetContentRoot(), OutPath);
+		return true;
+	}
+
+	OutPath.Reset();
+	return false;
+}
+
+bool FPjcPaths::FileToObjectPath(FStringView InFilePath, FStringBuilderBase& OutObjectPath)
+{
+	int32 SlashIndex = INDEX_NONE;
+	if (!InFilePath.FindLastChar(TEXT('/'), SlashIndex) || !ToRelative(InFilePath.Left(SlashIndex), OutObjectPath)) return false;
+
+	FStringView FileName = InFilePath.RightChop(SlashIndex + 1);
+
+	int32 DotIndex = INDEX_NONE;
+	if (FileName.FindLastChar(TEXT('.'), DotIndex))
+	{
+		FileName = FileName.Left(DotIndex);
+	}
+
+	if (FileName.Len() == 0)
+	{
+		OutObjectPath.Reset();
+		return false;
+	}
+
+	OutObjectPath << TEXT('/') << FileName << TEXT('.') << FileName;
+	return true;
+}
+
+bool FPjcPaths::ExportTextToObjectPath(FStringView InPath, FStringBuilderBase& OutObjectPath)
+{
+	OutObjectPath.Reset();
+
+	InPath = PjcPathsLocal::ExportTextStrip(InPath);
+	if (!PjcPathsLocal::StartsWithDir(InPath, GetContentRoot())) return false;
+	if (!PjcPathsLocal::IsObjectPath(InPath)) return false;
+
+	OutObjectPath << InPath;
+	return true;
+}
+
+bool FPjcPaths::ExportTextToObjectPath(FStringView InPath, const TArray<FString>& InRoots, FStringBuilderBase& OutObjectPath)
+{
+	OutObjectPath.Reset();
+
+	InPath = PjcPathsLocal::ExportTextStrip(InPath);
+
+	const bool bMounted = InRoots.ContainsByPredicate([&](const FString& Root)
+	{
+		return PjcPathsLocal::StartsWithDir(InPath, PjcPathsLocal::TrimSlashEnd(Root));
+	});
+	if (!bMounted) return false;
+	if (!PjcPathsLocal::IsObjectPath(InPath)) return false;
+
+	OutObjectPath << InPath;
+	return true;
+}
+
+FStringView FPjcPaths::GetContentDir()
+{
+	return PjcPathsLocal::GetMountPoint().ContentDir;
+}
+
+FStringView FPjcPaths::GetContentRoot()
+{
+	return PjcPathsLocal::GetMountPoint().ContentRoot;
+}
+
+bool FPjcPaths::IsUnderContentDir(FStringView InPath)
+{
+	return PjcPathsLocal::StartsWithDir(InPath, GetContentDir());
+}
+
+bool FPjcPaths::IsUnderContentRoot(FStringView InPath)
+{
+	return PjcPathsLocal::StartsWithDir(InPath, GetContentRoot());
+}
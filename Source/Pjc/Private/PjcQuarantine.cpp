@@ -0,0 +1,215 @@
+﻿// Copyright Ashot Barkhudaryan. All Rights Reserved.
+
+#include "PjcQuarantine.h"
+#include "PjcConstants.h"
+#include "Pjc.h"
+// Engine Headers
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace PjcQuarantineLocal
+{
+	static constexpr int32 Version = 1;
+	static constexpr int32 ProgressBatchSize = 256;
+	static const FString ManifestName{TEXT("Manifest.json")};
+}
+
+int32 FPjcQuarantine::Move(const TArray<FString>& InFiles, FString& OutQuarantineId, const bool bShowSlowTask)
+{
+	const FString ProjectDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir());
+
+	// manifest stores project relative paths, so quarantine stays valid if project folder is moved
+	TArray<FString> Files;
+	Files.Reserve(InFiles.Num());
+
+	for (const auto& File : InFiles)
+	{
+		FString FileRel = FPaths::ConvertRelativePathToFull(File);
+		if (!FPaths::MakePathRelativeTo(FileRel, *ProjectDir) || FileRel.StartsWith(TEXT("..")))
+		{
+			UE_LOG(LogProjectCleaner, Warning, TEXT("File %s is outside of project folder and can not be quarantined"), *File);
+			continue;
+		}
+
+		Files.Emplace(MoveTemp(FileRel));
+	}
+
+	const FString Timestamp = FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S"));
+	OutQuarantineId = Timestamp;
+
+	for (int32 Suffix = 1; IFileManager::Get().DirectoryExists(*GetQuarantineDir(OutQuarantineId)); ++Suffix)
+	{
+		OutQuarantineId = FString::Printf(TEXT("%s_%d"), *Timestamp, Suffix);
+	}
+
+	if (Files.Num() == 0) return 0;
+
+	if (!ManifestSave(OutQuarantineId, Files))
+	{
+		UE_LOG(LogProjectCleaner, Error, TEXT("Failed to write quarantine manifest to %s"), *GetQuarantineDir(OutQuarantineId));
+		return 0;
+	}
+
+	FScopedSlowTask SlowTask(
+		Files.Num(),
+		FText::FromString(TEXT("Moving files to quarantine...")),
+		bShowSlowTask && GIsEditor && !IsRunningCommandlet()
+	);
+	SlowTask.MakeDialog(false, false);
+
+	const FString QuarantineDir = GetQuarantineDir(OutQuarantineId);
+	int32 NumFilesMoved = 0;
+
+	for (int32 Index = 0; Index < Files.Num(); ++Index)
+	{
+		const FString Src = ProjectDir / Files[Index];
+		const FString Dst = QuarantineDir / Files[Index];
+
+		if (IFileManager::Get().Move(*Dst, *Src, false, false, false, true))
+		{
+			++NumFilesMoved;
+		}
+		else
+		{
+			UE_LOG(LogProjectCleaner, Error, TEXT("Failed to move file to quarantine: %s"), *Src);
+		}
+
+		if ((Index + 1) % PjcQuarantineLocal::ProgressBatchSize == 0 || Index + 1 == Files.Num())
+		{
+			const int32 NumFilesBatch = (Index % PjcQuarantineLocal::ProgressBatchSize) + 1;
+			SlowTask.EnterProgressFrame(NumFilesBatch, FText::FromString(FString::Printf(TEXT("Moved %d of %d files"), NumFilesMoved, Files.Num())));
+		}
+	}
+
+	return NumFilesMoved;
+}
+
+bool FPjcQuarantine::Restore(const FString& InQuarantineId, TArray<FString>& OutFilesRestored, const bool bShowSlowTask)
+{
+	OutFilesRestored.Reset();
+
+	TArray<FString> Files;
+	if (!ManifestLoad(InQuarantineId, Files))
+	{
+		UE_LOG(LogProjectCleaner, Error, TEXT("Failed to read manifest of quarantine %s"), *InQuarantineId);
+		return false;
+	}
+
+	FScopedSlowTask SlowTask(
+		Files.Num(),
+		FText::FromString(TEXT("Restoring files from quarantine...")),
+		bShowSlowTask && GIsEditor && !IsRunningCommandlet()
+	);
+	SlowTask.MakeDialog(false, false);
+
+	const FString ProjectDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir());
+	const FString QuarantineDir = GetQuarantineDir(InQuarantineId);
+	bool bErrors = false;
+
+	for (int32 Index = 0; Index < Files.Num(); ++Index)
+	{
+		const FString Src = QuarantineDir / Files[Index];
+		const FString Dst = ProjectDir / Files[Index];
+
+		// manifest is written before files are moved, so interrupted quarantine lists files that never left
+		if (IFileManager::Get().FileExists(*Src))
+		{
+			if (IFileManager::Get().FileExists(*Dst))
+			{
+				bErrors = true;
+				UE_LOG(LogProjectCleaner, Error, TEXT("Failed to restore file, because it was created again: %s"), *Dst);
+			}
+			else if (IFileManager::Get().Move(*Dst, *Src, false, false, false, true))
+			{
+				OutFilesRestored.Add(Dst);
+			}
+			else
+			{
+				bErrors = true;
+				UE_LOG(LogProjectCleaner, Error, TEXT("Failed to restore file: %s"), *Dst);
+			}
+		}
+
+		if ((Index + 1) % PjcQuarantineLocal::ProgressBatchSize == 0 || Index + 1 == Files.Num())
+		{
+			const int32 NumFilesBatch = (Index % PjcQuarantineLocal::ProgressBatchSize) + 1;
+			SlowTask.EnterProgressFrame(NumFilesBatch, FText::FromString(FString::Printf(TEXT("Restored %d of %d files"), OutFilesRestored.Num(), Files.Num())));
+		}
+	}
+
+	if (bErrors) return false;
+
+	return Purge(InQuarantineId);
+}
+
+bool FPjcQuarantine::Purge(const FString& InQuarantineId)
+{
+	if (InQuarantineId.IsEmpty()) return false;
+
+	const FString QuarantineDir = GetQuarantineDir(InQuarantineId);
+	if (!IFileManager::Get().DirectoryExists(*QuarantineDir)) return false;
+
+	return IFileManager::Get().DeleteDirectory(*QuarantineDir, false, true);
+}
+
+void FPjcQuarantine::GetQuarantineIds(TArray<FString>& OutQuarantineIds)
+{
+	OutQuarantineIds.Reset();
+
+	IFileManager::Get().FindFiles(OutQuarantineIds, *(GetQuarantineDir() / TEXT("*")), false, true);
+
+	// ids are timestamps, so sorting by name sorts by time
+	OutQuarantineIds.Sort();
+}
+
+FString FPjcQuarantine::GetQuarantineDir()
+{
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / PjcConstants::PathSavedDirName / PjcConstants::PathQuarantineDirName);
+}
+
+FString FPjcQuarantine::GetQuarantineDir(const FString& InQuarantineId)
+{
+	return GetQuarantineDir() / InQuarantineId;
+}
+
+bool FPjcQuarantine::ManifestSave(const FString& InQuarantineId, const TArray<FString>& InFiles)
+{
+	TArray<TSharedPtr<FJsonValue>> FileValues;
+	FileValues.Reserve(InFiles.Num());
+
+	for (const auto& File : InFiles)
+	{
+		FileValues.Emplace(MakeShared<FJsonValueString>(File));
+	}
+
+	const TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetNumberField(TEXT("Version"), PjcQuarantineLocal::Version);
+	Root->SetStringField(TEXT("Created"), FDateTime::Now().ToString());
+	Root->SetArrayField(TEXT("Files"), FileValues);
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	if (!FJsonSerializer::Serialize(Root, Writer)) return false;
+
+	return FFileHelper::SaveStringToFile(Json, *(GetQuarantineDir(InQuarantineId) / PjcQuarantineLocal::ManifestName), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
+
+bool FPjcQuarantine::ManifestLoad(const FString& InQuarantineId, TArray<FString>& OutFiles)
+{
+	OutFiles.Reset();
+
+	FString Json;
+	if (!FFileHelper::LoadFileToString(Json, *(GetQuarantineDir(InQuarantineId) / PjcQuarantineLocal::ManifestName))) return false;
+
+	TSharedPtr<FJsonObject> Root;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid()) return false;
+
+	if (static_cast<int32>(Root->GetNumberField(TEXT("Version"))) != PjcQuarantineLocal::Version) return false;
+
+	return Root->TryGetStringArrayField(TEXT("Files"), OutFiles);
+}
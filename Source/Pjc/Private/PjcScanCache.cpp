@@ -0,0 +1,277 @@
+﻿// Copyright Ashot Barkhudaryan. All Rights Reserved.
+
+#include "PjcScanCache.h"
+#include "PjcConstants.h"
+#include "Pjc.h"
+// Engine Headers
+#include "Hash/CityHash.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace PjcScanCacheLocal
+{
+	static constexpr uint32 Magic = 0x504A4353; // PJCS
+	static constexpr int32 Version = 2;
+	static constexpr uint32 IndexMagic = 0x504A4349; // PJCI
+	static constexpr int32 IndexVersion = 1;
+}
+
+void FPjcScanCache::Load(const FString& InScannerKey)
+{
+	ScannerKey = InScannerKey;
+	Entries.Reset();
+	ConfigEntries.Reset();
+
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *GetCacheFilePath(), FILEREAD_Silent)) return;
+
+	FMemoryReader Reader{Data};
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	FString Key;
+	Reader << Magic;
+	Reader << Version;
+
+	if (Magic != PjcScanCacheLocal::Magic || Version != PjcScanCacheLocal::Version) return;
+
+	Reader << Key;
+	if (!Key.Equals(ScannerKey)) return;
+
+	TArray<FPjcScanCacheEntry> LoadedEntries;
+	TArray<FPjcScanConfigEntry> LoadedConfigEntries;
+	Reader << LoadedEntries;
+	Reader << LoadedConfigEntries;
+
+	if (Reader.IsError())
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Indirect scan cache is corrupted, full scan will be performed"));
+		return;
+	}
+
+	Entries.Reserve(LoadedEntries.Num());
+
+	for (auto& Entry : LoadedEntries)
+	{
+		const FString FilePath = Entry.FilePath;
+		Entries.Emplace(FilePath, MoveTemp(Entry));
+	}
+
+	for (auto& ConfigEntry : LoadedConfigEntries)
+	{
+		const FString BranchPath = ConfigEntry.BranchPath;
+		ConfigEntries.Emplace(BranchPath, MoveTemp(ConfigEntry));
+	}
+}
+
+void FPjcScanCache::Save(TArray<FPjcScanCacheEntry>&& InEntries, TArray<FPjcScanConfigEntry>&& InConfigEntries)
+{
+	TArray<uint8> Data;
+	FMemoryWriter Writer{Data};
+
+	uint32 Magic = PjcScanCacheLocal::Magic;
+	int32 Version = PjcScanCacheLocal::Version;
+	Writer << Magic;
+	Writer << Version;
+	Writer << ScannerKey;
+	Writer << InEntries;
+	Writer << InConfigEntries;
+
+	if (!FFileHelper::SaveArrayToFile(Data, *GetCacheFilePath()))
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Failed to save indirect scan cache to %s"), *GetCacheFilePath());
+	}
+
+	Entries.Reset();
+	Entries.Reserve(InEntries.Num());
+
+	for (auto& Entry : InEntries)
+	{
+		const FString FilePath = Entry.FilePath;
+		Entries.Emplace(FilePath, MoveTemp(Entry));
+	}
+
+	ConfigEntries.Reset();
+	ConfigEntries.Reserve(InConfigEntries.Num());
+
+	for (auto& ConfigEntry : InConfigEntries)
+	{
+		const FString BranchPath = ConfigEntry.BranchPath;
+		ConfigEntries.Emplace(BranchPath, MoveTemp(ConfigEntry));
+	}
+}
+
+const FPjcScanCacheEntry* FPjcScanCache::Find(const FString& InFilePath) const
+{
+	return Entries.Find(InFilePath);
+}
+
+const FPjcScanConfigEntry* FPjcScanCache::FindConfig(const FString& InBranchPath) const
+{
+	return ConfigEntries.Find(InBranchPath);
+}
+
+FString FPjcScanCache::GetCacheFilePath()
+{
+	return FPaths::ProjectSavedDir() / PjcConstants::PathSavedDirName / PjcConstants::FileScanCacheName;
+}
+
+uint64 FPjcScanCache::GetHash(const uint8* Data, const int64 Size)
+{
+	if (!Data || Size <= 0) return 0;
+
+	// CityHash64 takes 32 bit length, so huge files hashed by chunks
+	constexpr int64 ChunkSize = MAX_int32;
+
+	uint64 Hash = 0;
+	int64 Offset = 0;
+
+	while (Offset < Size)
+	{
+		const int64 Len = FMath::Min(ChunkSize, Size - Offset);
+		const uint64 ChunkHash = CityHash64(reinterpret_cast<const char*>(Data + Offset), static_cast<uint32>(Len));
+		Hash = Offset == 0 ? ChunkHash : CityHash128to64(Uint128_64{Hash, ChunkHash});
+		Offset += Len;
+	}
+
+	return Hash;
+}
+
+void FPjcIndirectIndex::Build(const TArray<FPjcAssetIndirectInfo>& InAssetsIndirectInfos)
+{
+	Files.Reset();
+	Refs.Reset();
+
+	// file paths are interned, every reference stores only index into file table
+	TMap<FString, int32> FileIds;
+
+	for (const auto& Info : InAssetsIndirectInfos)
+	{
+		const int32* FileIdPtr = FileIds.Find(Info.FilePath);
+		const int32 FileId = FileIdPtr ? *FileIdPtr : FileIds.Add(Info.FilePath, Files.Add(Info.FilePath));
+
+		Refs.FindOrAdd(Info.Asset.ObjectPath).Emplace(FPjcIndirectIndexRef{FileId, Info.FileNum});
+	}
+
+	bValid = true;
+}
+
+bool FPjcIndirectIndex::Load()
+{
+	Files.Reset();
+	Refs.Reset();
+	bValid = false;
+
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *GetIndexFilePath(), FILEREAD_Silent)) return false;
+
+	FMemoryReader Reader{Data};
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Reader << Magic;
+	Reader << Version;
+
+	if (Magic != PjcScanCacheLocal::IndexMagic || Version != PjcScanCacheLocal::IndexVersion) return false;
+
+	Reader << Files;
+
+	int32 NumRefs = 0;
+	Reader << NumRefs;
+
+	if (Reader.IsError() || NumRefs < 0) return false;
+
+	Refs.Reserve(NumRefs);
+
+	for (int32 i = 0; i < NumRefs; ++i)
+	{
+		FString ObjectPath;
+		TArray<FPjcIndirectIndexRef> AssetRefs;
+		Reader << ObjectPath;
+		Reader << AssetRefs;
+
+		if (Reader.IsError()) break;
+
+		Refs.Emplace(FName{*ObjectPath}, MoveTemp(AssetRefs));
+	}
+
+	if (Reader.IsError())
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Indirect assets index is corrupted, rescan required"));
+		Files.Reset();
+		Refs.Reset();
+		return false;
+	}
+
+	bValid = true;
+	return true;
+}
+
+void FPjcIndirectIndex::Save() const
+{
+	TArray<uint8> Data;
+	FMemoryWriter Writer{Data};
+
+	uint32 Magic = PjcScanCacheLocal::IndexMagic;
+	int32 Version = PjcScanCacheLocal::IndexVersion;
+	Writer << Magic;
+	Writer << Version;
+	Writer << const_cast<TArray<FString>&>(Files);
+
+	int32 NumRefs = Refs.Num();
+	Writer << NumRefs;
+
+	for (const auto& Ref : Refs)
+	{
+		FString ObjectPath = Ref.Key.ToString();
+		Writer << ObjectPath;
+		Writer << const_cast<TArray<FPjcIndirectIndexRef>&>(Ref.Value);
+	}
+
+	if (!FFileHelper::SaveArrayToFile(Data, *GetIndexFilePath()))
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Failed to save indirect assets index to %s"), *GetIndexFilePath());
+	}
+}
+
+void FPjcIndirectIndex::Find(const FName& InObjectPath, TArray<FPjcFileInfo>& OutFileInfos) const
+{
+	OutFileInfos.Reset();
+
+	const TArray<FPjcIndirectIndexRef>* AssetRefs = Refs.Find(InObjectPath);
+	if (!AssetRefs) return;
+
+	OutFileInfos.Reserve(AssetRefs->Num());
+
+	for (const auto& Ref : *AssetRefs)
+	{
+		if (!Files.IsValidIndex(Ref.FileId)) continue;
+
+		FPjcFileInfo FileInfo;
+		FileInfo.FilePath = Files[Ref.FileId];
+		FileInfo.FileNum = Ref.FileNum;
+
+		OutFileInfos.Emplace(MoveTemp(FileInfo));
+	}
+}
+
+bool FPjcIndirectIndex::IsValid() const
+{
+	return bValid;
+}
+
+const TArray<FString>& FPjcIndirectIndex::GetFiles() const
+{
+	return Files;
+}
+
+const TMap<FName, TArray<FPjcIndirectIndexRef>>& FPjcIndirectIndex::GetRefs() const
+{
+	return Refs;
+}
+
+FString FPjcIndirectIndex::GetIndexFilePath()
+{
+	return FPaths::ProjectSavedDir() / PjcConstants::PathSavedDirName / PjcConstants::FileIndirectIndexName;
+}
@@ -2,32 +2,86 @@
 
 #include "PjcSubsystem.h"
 #include "PjcConstants.h"
+#include "PjcContentIndex.h"
+#include "PjcDeletionJournal.h"
+#include "PjcDeletionPlan.h"
+#include "PjcDirectoryWalker.h"
+#include "PjcDuplicateFinder.h"
+#include "PjcIndirectScanner.h"
+#include "PjcPackageValidator.h"
+#include "PjcPaths.h"
+#include "PjcQuarantine.h"
 #include "Pjc.h"
 // Engine Headers
 #include "AssetManagerEditorModule.h"
 #include "AssetViewUtils.h"
+#include "DirectoryWatcherModule.h"
 #include "EditorTutorial.h"
 #include "EditorUtilityBlueprint.h"
 #include "EditorUtilityWidget.h"
 #include "EditorUtilityWidgetBlueprint.h"
 #include "FileHelpers.h"
+#include "IDirectoryWatcher.h"
 #include "ObjectTools.h"
+#include "ISourceControlModule.h"
+#include "ISourceControlProvider.h"
 #include "ShaderCompiler.h"
+#include "SourceCodeNavigation.h"
+#include "SourceControlOperations.h"
+#include "Async/ParallelFor.h"
 #include "Engine/AssetManager.h"
 #include "Framework/Notifications/NotificationManager.h"
-#include "Internationalization/Regex.h"
 #include "Misc/FileHelper.h"
 #include "Misc/ScopedSlowTask.h"
 
+namespace PjcSubsystemLocal
+{
+	static FPjcIndirectIndex IndirectIndex;
+	static bool bIndirectIndexLoaded = false;
+}
+
 void UPjcSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
 
 	bFirstScan = true;
+
+	// content table is kept up to date by directory watcher, so files views are updated without walking Content folder
+	if (!IsRunningCommandlet())
+	{
+		FDirectoryWatcherModule& DirectoryWatcherModule = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+		IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule.Get();
+
+		if (DirectoryWatcher)
+		{
+			DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(
+				FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir()),
+				IDirectoryWatcher::FDirectoryChanged::CreateStatic(&FPjcContentIndex::ApplyChanges),
+				DirectoryWatcherHandle,
+				IDirectoryWatcher::WatchOptions::IncludeDirectoryChanges
+			);
+
+			FPjcContentIndex::SetLive(DirectoryWatcherHandle.IsValid());
+		}
+	}
 }
 
 void UPjcSubsystem::Deinitialize()
 {
+	if (DirectoryWatcherHandle.IsValid())
+	{
+		FDirectoryWatcherModule* DirectoryWatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+		IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule ? DirectoryWatcherModule->Get() : nullptr;
+
+		if (DirectoryWatcher)
+		{
+			DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir()), DirectoryWatcherHandle);
+		}
+
+		DirectoryWatcherHandle.Reset();
+		FPjcContentIndex::SetLive(false);
+	}
+
 	Super::Deinitialize();
 }
 
@@ -177,54 +231,239 @@ void UPjcSubsystem::GetAssetsIndirect(TArray<FAssetData>& Assets, TArray<FPjcAss
 	Assets.Reset();
 	AssetsIndirectInfos.Reset();
 
-	TSet<FString> ScanFiles;
-	GetSourceAndConfigFiles(ScanFiles);
+	TSet<FString> ScanFilesSet;
+	GetSourceAndConfigFiles(ScanFilesSet);
+
+	// files are sorted, so results does not depend on set iteration order or on how workers were scheduled
+	TArray<FString> ScanFiles = ScanFilesSet.Array();
+	ScanFiles.Sort();
 
 	FScopedSlowTask SlowTask{
-		static_cast<float>(ScanFiles.Num()),
+		2.0f,
 		FText::FromString(TEXT("Searching Indirectly used assets...")),
 		bShowSlowTask && GIsEditor && !IsRunningCommandlet()
 	};
 	SlowTask.MakeDialog(false, false);
+	SlowTask.EnterProgressFrame(1.0f, FText::FromString(FString::Printf(TEXT("Scanning %d source, config and data files..."), ScanFiles.Num())));
 
-	for (const auto& File : ScanFiles)
-	{
-		SlowTask.EnterProgressFrame(1.0f, FText::FromString(File));
+	// every file has its own slot for matches and cache entry, so workers never write to shared containers
+	TArray<TArray<FPjcAssetIndirectMatch>> MatchesByFile;
+	TArray<FPjcScanCacheEntry> CacheEntries;
+	MatchesByFile.SetNum(ScanFiles.Num());
+	CacheEntries.SetNum(ScanFiles.Num());
+
+	// all mount points are searched in single pass, candidates under any of them are resolved to assets below
+	const TArray<FString> MountPrefixes = FPjcIndirectScanners::GetMountPrefixes();
+	const FPjcIndirectScanners Scanners{MountPrefixes};
 
-		FString FileContent;
-		FFileHelper::LoadFileToString(FileContent, *File);
+	FPjcScanCache ScanCache;
+	ScanCache.Load(Scanners.GetKey());
 
-		if (FileContent.IsEmpty()) continue;
+	// ini files that are part of config hierarchy contribute only values that are effective after merging
+	const FPjcConfigScanner ConfigScanner{MountPrefixes};
+	TArray<FPjcScanConfigEntry> ConfigEntries;
+	ConfigScanner.Scan(ScanCache, ConfigEntries);
 
-		static FRegexPattern Pattern(TEXT(R"(\/Game([A-Za-z0-9_.\/]+)\b)"));
-		FRegexMatcher Matcher(Pattern, FileContent);
-		while (Matcher.FindNext())
+	TMap<FString, TSet<FString>> EffectiveCandidatesByFile;
+	for (const auto& ConfigEntry : ConfigEntries)
+	{
+		for (const auto& HierarchyFile : ConfigEntry.HierarchyFiles)
 		{
-			FString FoundedAssetObjectPath = Matcher.GetCaptureGroup(0);
+			EffectiveCandidatesByFile.FindOrAdd(HierarchyFile).Append(ConfigEntry.Candidates);
+		}
+	}
+
+	ParallelFor(ScanFiles.Num(), [&](const int32 FileIndex)
+	{
+		const FString& File = ScanFiles[FileIndex];
+
+		const IPjcIndirectScanner* Scanner = Scanners.Find(File);
+		if (!Scanner) return;
 
-			const FString ObjectPath = PathConvertToObjectPath(FoundedAssetObjectPath);
-			if (ObjectPath.IsEmpty()) continue;
+		const FFileStatData StatData = IFileManager::Get().GetStatData(*File);
+		if (!StatData.bIsValid) return;
 
-			const FAssetData AssetData = GetModuleAssetRegistry().Get().GetAssetByObjectPath(FName{*ObjectPath});
-			if (!AssetData.IsValid()) continue;
+		FPjcScanCacheEntry& CacheEntry = CacheEntries[FileIndex];
+		CacheEntry.FilePath = File;
+		CacheEntry.FileSize = StatData.FileSize;
+		CacheEntry.FileTime = StatData.ModificationTime;
+
+		// unchanged files are not even opened
+		const FPjcScanCacheEntry* CachedEntry = ScanCache.Find(File);
+		if (CachedEntry && CachedEntry->FileSize == StatData.FileSize && CachedEntry->FileTime == StatData.ModificationTime)
+		{
+			CacheEntry.FileHash = CachedEntry->FileHash;
+			CacheEntry.Candidates = CachedEntry->Candidates;
+		}
+		else
+		{
+			// file bytes are scanned in place, only matched paths are converted to strings
+			FPjcScanFile FileContent;
+			if (!FileContent.Open(File))
+			{
+				CacheEntry.FilePath.Reset();
+				return;
+			}
 
-			// if founded asset is ok, we loading file lines to determine on what line its used
-			TArray<FString> Lines;
-			FFileHelper::LoadFileToStringArray(Lines, *File);
+			CacheEntry.FileHash = FPjcScanCache::GetHash(FileContent.GetData(), FileContent.GetSize());
 
-			for (int32 i = 0; i < Lines.Num(); ++i)
+			// touched, but not modified files (like after branch switch) still reuse cached results
+			if (CachedEntry && CachedEntry->FileHash == CacheEntry.FileHash)
+			{
+				CacheEntry.Candidates = CachedEntry->Candidates;
+			}
+			else
 			{
-				if (!Lines.IsValidIndex(i)) continue;
-				if (!Lines[i].Contains(FoundedAssetObjectPath)) continue;
+				Scanner->Scan(FileContent.GetData(), FileContent.GetSize(), CacheEntry.Candidates);
+			}
+		}
+
+		TArray<FPjcAssetIndirectMatch>& Matches = MatchesByFile[FileIndex];
+
+		const TSet<FString>* EffectiveCandidates = EffectiveCandidatesByFile.Find(File);
+
+		// candidates are parsed as text only, scanned source files never point to real files on disk
+		TStringBuilder<256> ObjectPath;
+		for (const auto& Candidate : CacheEntry.Candidates)
+		{
+			// text of project or plugin ini used only to find line of effective value, commented out or removed values are skipped.
+			// effective values that are not written in any of those inis come from engine or saved inis and are not project references.
+			if (EffectiveCandidates && !EffectiveCandidates->Contains(Candidate.Path)) continue;
+			if (!FPjcPaths::ExportTextToObjectPath(Candidate.Path, MountPrefixes, ObjectPath)) continue;
+
+			Matches.Emplace(FPjcAssetIndirectMatch{FName{ObjectPath.Len(), ObjectPath.GetData()}, Candidate.FileNum});
+		}
+	});
+
+	// files that no longer exist or failed to read are dropped from cache
+	CacheEntries.RemoveAll([](const FPjcScanCacheEntry& Entry)
+	{
+		return Entry.FilePath.IsEmpty();
+	});
+	ScanCache.Save(MoveTemp(CacheEntries), MoveTemp(ConfigEntries));
+
+	SlowTask.EnterProgressFrame(1.0f, FText::FromString(TEXT("Resolving indirectly used assets...")));
+
+	// all candidates resolved against single package table, instead of querying AssetRegistry per match
+	TSet<FName> CandidatePaths;
+	for (const auto& Matches : MatchesByFile)
+	{
+		for (const auto& Match : Matches)
+		{
+			CandidatePaths.Add(Match.ObjectPath);
+		}
+	}
+
+	TArray<FAssetData> AssetsAll;
+	GetAssetsAll(AssetsAll);
+
+	TMap<FName, const FAssetData*> ResolvedAssets;
+	ResolvedAssets.Reserve(CandidatePaths.Num());
+
+	for (const auto& Asset : AssetsAll)
+	{
+		if (CandidatePaths.Contains(Asset.ObjectPath))
+		{
+			ResolvedAssets.Add(Asset.ObjectPath, &Asset);
+		}
+	}
+
+	// candidates under other mount points (plugin or engine content) are not in /Game table, those are resolved through AssetRegistry.
+	// plugin assets referenced from project files then keep their /Game dependencies used.
+	TArray<FAssetData> AssetsMounted;
+	for (const auto& CandidatePath : CandidatePaths)
+	{
+		if (ResolvedAssets.Contains(CandidatePath)) continue;
+
+		FAssetData AssetData = GetModuleAssetRegistry().Get().GetAssetByObjectPath(CandidatePath);
+		if (!AssetData.IsValid()) continue;
+
+		AssetsMounted.Emplace(MoveTemp(AssetData));
+	}
+
+	for (const auto& Asset : AssetsMounted)
+	{
+		ResolvedAssets.Add(Asset.ObjectPath, &Asset);
+	}
+
+	TSet<FAssetData> AssetsAdded;
+	TSet<FPjcAssetIndirectInfo> InfosAdded;
 
-				const FString FilePathAbs = FPaths::ConvertRelativePathToFull(File);
-				const int32 FileLine = i + 1;
+	for (int32 FileIndex = 0; FileIndex < ScanFiles.Num(); ++FileIndex)
+	{
+		const TArray<FPjcAssetIndirectMatch>& Matches = MatchesByFile[FileIndex];
+		if (Matches.Num() == 0) continue;
+
+		const FString FilePathAbs = FPaths::ConvertRelativePathToFull(ScanFiles[FileIndex]);
+
+		for (const auto& Match : Matches)
+		{
+			const FAssetData* const* AssetData = ResolvedAssets.Find(Match.ObjectPath);
+			if (!AssetData) continue;
 
-				AssetsIndirectInfos.AddUnique(FPjcAssetIndirectInfo{AssetData, FilePathAbs, FileLine});
-				Assets.AddUnique(AssetData);
+			bool bIsAlreadyInSet = false;
+			FPjcAssetIndirectInfo Info{**AssetData, FilePathAbs, Match.FileNum};
+			InfosAdded.Add(Info, &bIsAlreadyInSet);
+			if (!bIsAlreadyInSet)
+			{
+				AssetsIndirectInfos.Emplace(MoveTemp(Info));
+			}
+
+			AssetsAdded.Add(**AssetData, &bIsAlreadyInSet);
+			if (!bIsAlreadyInSet)
+			{
+				Assets.Emplace(**AssetData);
 			}
 		}
 	}
+
+	// in memory index is replaced too, so lookups after scan do not read index file again
+	PjcSubsystemLocal::IndirectIndex.Build(AssetsIndirectInfos);
+	PjcSubsystemLocal::IndirectIndex.Save();
+	PjcSubsystemLocal::bIndirectIndexLoaded = true;
+}
+
+bool UPjcSubsystem::GetAssetsIndirectFromIndex(TArray<FAssetData>& Assets, TArray<FPjcAssetIndirectInfo>& AssetsIndirectInfos)
+{
+	Assets.Reset();
+	AssetsIndirectInfos.Reset();
+
+	if (GetModuleAssetRegistry().Get().IsLoadingAssets()) return false;
+
+	const FPjcIndirectIndex& IndirectIndex = GetIndirectIndex();
+	if (!IndirectIndex.IsValid()) return false;
+
+	const TArray<FString>& Files = IndirectIndex.GetFiles();
+
+	for (const auto& Ref : IndirectIndex.GetRefs())
+	{
+		// assets deleted or renamed since last scan are skipped
+		const FAssetData AssetData = GetModuleAssetRegistry().Get().GetAssetByObjectPath(Ref.Key);
+		if (!AssetData.IsValid()) continue;
+
+		Assets.Emplace(AssetData);
+
+		for (const auto& AssetRef : Ref.Value)
+		{
+			if (!Files.IsValidIndex(AssetRef.FileId)) continue;
+
+			AssetsIndirectInfos.Emplace(FPjcAssetIndirectInfo{AssetData, Files[AssetRef.FileId], AssetRef.FileNum});
+		}
+	}
+
+	return true;
+}
+
+void UPjcSubsystem::GetAssetIndirectReferences(const FAssetData& InAsset, TArray<FPjcFileInfo>& FileInfos)
+{
+	FileInfos.Reset();
+
+	if (!InAsset.IsValid()) return;
+
+	const FPjcIndirectIndex& IndirectIndex = GetIndirectIndex();
+	if (!IndirectIndex.IsValid()) return;
+
+	IndirectIndex.Find(InAsset.ObjectPath, FileInfos);
 }
 
 void UPjcSubsystem::GetAssetsCircular(TArray<FAssetData>& Assets, const bool bShowSlowTask)
@@ -412,6 +651,52 @@ void UPjcSubsystem::GetAssetsExtReferenced(TArray<FAssetData>& Assets, const boo
 	Assets.Shrink();
 }
 
+void UPjcSubsystem::GetAssetsDuplicate(TArray<FAssetData>& Assets, const bool bShowSlowTask)
+{
+	if (GetModuleAssetRegistry().Get().IsLoadingAssets()) return;
+
+	TArray<FPjcDuplicateGroup> Groups;
+	GetDuplicateGroups(Groups, bShowSlowTask);
+
+	GetAssetsByDuplicateGroups(Groups, Assets);
+}
+
+void UPjcSubsystem::GetAssetsByDuplicateGroups(const TArray<FPjcDuplicateGroup>& Groups, TArray<FAssetData>& Assets)
+{
+	TSet<FName> PackageNames;
+	TStringBuilder<256> ObjectPath;
+
+	for (const auto& Group : Groups)
+	{
+		for (const auto& File : Group.Files)
+		{
+			if (!FPjcPaths::FileToObjectPath(File, ObjectPath)) continue;
+
+			// object path is Package.Asset, only package part is needed
+			const FStringView ObjectPathView = ObjectPath.ToView();
+			int32 DotIndex = INDEX_NONE;
+			if (!ObjectPathView.FindLastChar(TEXT('.'), DotIndex)) continue;
+
+			PackageNames.Add(FName{DotIndex, ObjectPathView.GetData()});
+		}
+	}
+
+	TArray<FAssetData> AssetsAll;
+	GetAssetsAll(AssetsAll);
+
+	Assets.Reset(PackageNames.Num());
+
+	for (const auto& Asset : AssetsAll)
+	{
+		if (PackageNames.Contains(Asset.PackageName))
+		{
+			Assets.Emplace(Asset);
+		}
+	}
+
+	Assets.Shrink();
+}
+
 void UPjcSubsystem::GetClassNamesPrimary(TSet<FName>& ClassNames)
 {
 	// getting list of primary asset classes that are defined in AssetManager
@@ -466,32 +751,15 @@ void UPjcSubsystem::GetFiles(const FString& InSearchPath, const bool bSearchRecu
 {
 	OutFiles.Empty();
 
-	struct FFindFilesVisitor : IPlatformFile::FDirectoryVisitor
-	{
-		TArray<FString>& Files;
-
-		explicit FFindFilesVisitor(TArray<FString>& InFiles) : Files(InFiles) { }
-
-		virtual bool Visit(const TCHAR* FilenameOrDirectory, bool bIsDirectory) override
-		{
-			if (!bIsDirectory)
-			{
-				Files.Emplace(FPaths::ConvertRelativePathToFull(FilenameOrDirectory));
-			}
-
-			return true;
-		}
-	};
+	TArray<FPjcDirectoryEntry> Files;
+	TArray<FPjcDirectoryEntry> Folders;
+	FPjcDirectoryWalker{bSearchRecursive}.Walk(InSearchPath, Files, Folders);
 
-	FFindFilesVisitor FindFilesVisitor{OutFiles};
+	OutFiles.Reserve(Files.Num());
 
-	if (bSearchRecursive)
+	for (auto& File : Files)
 	{
-		FPlatformFileManager::Get().GetPlatformFile().IterateDirectoryRecursively(*InSearchPath, FindFilesVisitor);
-	}
-	else
-	{
-		FPlatformFileManager::Get().GetPlatformFile().IterateDirectory(*InSearchPath, FindFilesVisitor);
+		OutFiles.Emplace(MoveTemp(File.Path));
 	}
 }
 
@@ -499,45 +767,6 @@ void UPjcSubsystem::GetFilesByExt(const FString& InSearchPath, const bool bSearc
 {
 	OutFiles.Empty();
 
-	struct FFindFilesVisitor : IPlatformFile::FDirectoryVisitor
-	{
-		const bool bSearchInvert;
-		TArray<FString>& Files;
-		const TSet<FString>& Extensions;
-
-		explicit FFindFilesVisitor(const bool bInSearchInvert, TArray<FString>& InFiles, const TSet<FString>& InExtensions)
-			: bSearchInvert(bInSearchInvert),
-			  Files(InFiles),
-			  Extensions(InExtensions) { }
-
-		virtual bool Visit(const TCHAR* FilenameOrDirectory, bool bIsDirectory) override
-		{
-			if (!bIsDirectory)
-			{
-				const FString FullPath = FPaths::ConvertRelativePathToFull(FilenameOrDirectory);
-
-				if (Extensions.Num() == 0)
-				{
-					Files.Emplace(FullPath);
-					return true;
-				}
-
-				const FString Ext = FPaths::GetExtension(FullPath, false);
-				const bool bExistsInSearchList = Extensions.Contains(Ext);
-
-				if (
-					(bExistsInSearchList && !bSearchInvert) ||
-					(!bExistsInSearchList && bSearchInvert)
-				)
-				{
-					Files.Emplace(FullPath);
-				}
-			}
-
-			return true;
-		}
-	};
-
 	TSet<FString> ExtensionsNormalized;
 	ExtensionsNormalized.Reserve(InExtensions.Num());
 
@@ -547,26 +776,64 @@ void UPjcSubsystem::GetFilesByExt(const FString& InSearchPath, const bool bSearc
 		ExtensionsNormalized.Emplace(ExtNormalized);
 	}
 
-	FFindFilesVisitor FindFilesVisitor{bExtSearchInvert, OutFiles, ExtensionsNormalized};
-	if (bSearchRecursive)
+	TArray<FPjcDirectoryEntry> Files;
+	TArray<FPjcDirectoryEntry> Folders;
+	FPjcDirectoryWalker{bSearchRecursive}.Walk(InSearchPath, Files, Folders);
+
+	OutFiles.Reserve(Files.Num());
+
+	for (auto& File : Files)
 	{
-		FPlatformFileManager::Get().GetPlatformFile().IterateDirectoryRecursively(*InSearchPath, FindFilesVisitor);
+		if (ExtensionsNormalized.Num() == 0)
+		{
+			OutFiles.Emplace(MoveTemp(File.Path));
+			continue;
+		}
+
+		const FString Ext = FPaths::GetExtension(File.Path, false);
+		const bool bExistsInSearchList = ExtensionsNormalized.Contains(Ext);
+
+		if (
+			(bExistsInSearchList && !bExtSearchInvert) ||
+			(!bExistsInSearchList && bExtSearchInvert)
+		)
+		{
+			OutFiles.Emplace(MoveTemp(File.Path));
+		}
 	}
-	else
+}
+
+void UPjcSubsystem::GetFilesExternalAll(TArray<FString>& Files)
+{
+	const FPjcContentIndex& ContentIndex = FPjcContentIndex::Get();
+	const TSet<int32> EngineExtIds = ContentIndex.GetExtIds(PjcConstants::EngineFileExtensions);
+
+	Files.Reset(ContentIndex.GetFiles().Num());
+
+	for (const auto& File : ContentIndex.GetFiles())
 	{
-		FPlatformFileManager::Get().GetPlatformFile().IterateDirectory(*InSearchPath, FindFilesVisitor);
+		if (EngineExtIds.Contains(File.ExtId)) continue;
+
+		Files.Emplace(File.Path);
 	}
+
+	Files.Shrink();
 }
 
-void UPjcSubsystem::GetFilesExternalAll(TArray<FString>& Files)
+void UPjcSubsystem::GetFilesExcludedBySettings(const UPjcFileExcludeSettings* InSettings, TSet<FString>& OutFiles)
 {
-	GetFilesByExt(
-		FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir()),
-		true,
-		true,
-		PjcConstants::EngineFileExtensions,
-		Files
-	);
+	OutFiles.Reset();
+
+	// excluded files are converted once, instead of converting all of them for every checked file
+	for (const auto& ExcludedFile : InSettings->ExcludedFiles)
+	{
+		if (!ExcludedFile.FilePath.StartsWith(TEXT("Content"))) continue;
+
+		const FString PathAbs = PathConvertToAbsolute(FPaths::ProjectDir() / ExcludedFile.FilePath);
+		if (PathAbs.IsEmpty()) continue;
+
+		OutFiles.Emplace(PathAbs);
+	}
 }
 
 void UPjcSubsystem::GetFilesExternalFiltered(TArray<FString>& Files, const bool bShowSlowTask)
@@ -577,6 +844,9 @@ void UPjcSubsystem::GetFilesExternalFiltered(TArray<FString>& Files, const bool
 	TArray<FString> FilesExternalAll;
 	GetFilesExternalAll(FilesExternalAll);
 
+	TSet<FString> FilesExcluded;
+	GetFilesExcludedBySettings(FileExcludeSettings, FilesExcluded);
+
 	Files.Reset(FilesExternalAll.Num());
 
 	FScopedSlowTask SlowTask(
@@ -592,16 +862,7 @@ void UPjcSubsystem::GetFilesExternalFiltered(TArray<FString>& Files, const bool
 
 		const FString FileExt = FPaths::GetExtension(File, false).ToLower();
 		const bool bExcludedByExt = FileExcludeSettings->ExcludedExtensions.Contains(FileExt);
-		const bool bExcludedByFile = FileExcludeSettings->ExcludedFiles.ContainsByPredicate([&](const FFilePath& InFilePath)
-		{
-			if (!InFilePath.FilePath.StartsWith(TEXT("Content"))) return false;
-
-			const FString Path = FPaths::ProjectDir() / InFilePath.FilePath;
-			const FString PathAbs = PathConvertToAbsolute(Path);
-			if (PathAbs.IsEmpty()) return false;
-
-			return File.Equals(PathAbs);
-		});
+		const bool bExcludedByFile = FilesExcluded.Contains(File);
 
 		if (bExcludedByExt || bExcludedByFile) continue;
 
@@ -619,6 +880,9 @@ void UPjcSubsystem::GetFilesExternalExcluded(TArray<FString>& Files, const bool
 	TArray<FString> FilesExternalAll;
 	GetFilesExternalAll(FilesExternalAll);
 
+	TSet<FString> FilesExcluded;
+	GetFilesExcludedBySettings(FileExcludeSettings, FilesExcluded);
+
 	Files.Reset(FilesExternalAll.Num());
 
 	FScopedSlowTask SlowTask(
@@ -634,16 +898,7 @@ void UPjcSubsystem::GetFilesExternalExcluded(TArray<FString>& Files, const bool
 
 		const FString FileExt = FPaths::GetExtension(File, false).ToLower();
 		const bool bExcludedByExt = FileExcludeSettings->ExcludedExtensions.Contains(FileExt);
-		const bool bExcludedByFile = FileExcludeSettings->ExcludedFiles.ContainsByPredicate([&](const FFilePath& InFilePath)
-		{
-			if (!InFilePath.FilePath.StartsWith(TEXT("Content"))) return false;
-
-			const FString Path = FPaths::ProjectDir() / InFilePath.FilePath;
-			const FString PathAbs = PathConvertToAbsolute(Path);
-			if (PathAbs.IsEmpty()) return false;
-
-			return File.Equals(PathAbs);
-		});
+		const bool bExcludedByFile = FilesExcluded.Contains(File);
 
 		if (bExcludedByExt || bExcludedByFile)
 		{
@@ -656,15 +911,16 @@ void UPjcSubsystem::GetFilesExternalExcluded(TArray<FString>& Files, const bool
 
 void UPjcSubsystem::GetFilesCorrupted(TArray<FString>& Files, const bool bShowSlowTask)
 {
+	const FPjcContentIndex& ContentIndex = FPjcContentIndex::Get();
+	const TSet<int32> EngineExtIds = ContentIndex.GetExtIds(PjcConstants::EngineFileExtensions);
+
 	TArray<FString> FileAssets;
+	for (const auto& File : ContentIndex.GetFiles())
+	{
+		if (!EngineExtIds.Contains(File.ExtId)) continue;
 
-	GetFilesByExt(
-		FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir()),
-		true,
-		false,
-		PjcConstants::EngineFileExtensions,
-		FileAssets
-	);
+		FileAssets.Emplace(File.Path);
+	}
 
 	Files.Reset(FileAssets.Num());
 
@@ -675,13 +931,14 @@ void UPjcSubsystem::GetFilesCorrupted(TArray<FString>& Files, const bool bShowSl
 	);
 	SlowTask.MakeDialog(false, false);
 
+	TStringBuilder<256> ObjectPath;
 	for (const auto& File : FileAssets)
 	{
 		SlowTask.EnterProgressFrame(1.0f, FText::FromString(File));
 
-		const FString Path = PathConvertToObjectPath(File);
-		if (Path.IsEmpty()) continue;
-		if (GetModuleAssetRegistry().Get().GetAssetByObjectPath(FName{*Path}).IsValid()) continue;
+		// files are taken from content table, so they can be converted to object path without file system check
+		FPjcPaths::FileToObjectPath(File, ObjectPath);
+		if (GetModuleAssetRegistry().Get().GetAssetByObjectPath(FName{ObjectPath.Len(), ObjectPath.GetData()}).IsValid()) continue;
 
 		Files.Emplace(File);
 	}
@@ -689,50 +946,95 @@ void UPjcSubsystem::GetFilesCorrupted(TArray<FString>& Files, const bool bShowSl
 	Files.Shrink();
 }
 
-void UPjcSubsystem::GetFolders(const FString& InSearchPath, const bool bSearchRecursive, TArray<FString>& OutFolders)
+void UPjcSubsystem::GetFilesSuspect(TArray<FString>& Files, const bool bShowSlowTask)
 {
-	OutFolders.Empty();
+	Files.Reset();
 
-	struct FFindFoldersVisitor : IPlatformFile::FDirectoryVisitor
+	if (GetModuleAssetRegistry().Get().IsLoadingAssets()) return;
+
+	const FPjcContentIndex& ContentIndex = FPjcContentIndex::Get();
+	const TSet<int32> PackageExtIds = ContentIndex.GetExtIds(PjcConstants::PackageFileExtensions);
+
+	TArray<FString> FilesRegistered;
+	TStringBuilder<256> ObjectPath;
+	for (const auto& File : ContentIndex.GetFiles())
 	{
-		TArray<FString>& Folders;
+		if (!PackageExtIds.Contains(File.ExtId)) continue;
 
-		explicit FFindFoldersVisitor(TArray<FString>& InFolders) : Folders(InFolders) { }
+		FPjcPaths::FileToObjectPath(File.Path, ObjectPath);
+		if (!GetModuleAssetRegistry().Get().GetAssetByObjectPath(FName{ObjectPath.Len(), ObjectPath.GetData()}).IsValid()) continue;
 
-		virtual bool Visit(const TCHAR* FilenameOrDirectory, bool bIsDirectory) override
-		{
-			if (bIsDirectory)
-			{
-				Folders.Emplace(FPaths::ConvertRelativePathToFull(FilenameOrDirectory));
-			}
+		FilesRegistered.Emplace(File.Path);
+	}
 
-			return true;
-		}
-	};
+	// packages known by asset registry still can be truncated or saved by newer engine, those are found by reading package headers only
+	FPjcPackageValidator::Validate(FilesRegistered, Files, bShowSlowTask);
+}
+
+void UPjcSubsystem::GetDuplicateGroups(TArray<FPjcDuplicateGroup>& Groups, const bool bShowSlowTask)
+{
+	FPjcDuplicateFinder::FindFiles(Groups, bShowSlowTask);
+
+	TArray<FAssetData> AssetsAll;
+	GetAssetsAll(AssetsAll);
 
-	FFindFoldersVisitor FindFoldersVisitor{OutFolders};
-	if (bSearchRecursive)
+	TArray<FPjcDuplicateGroup> GroupsSameSource;
+	FPjcDuplicateFinder::FindAssetsSameSource(AssetsAll, Groups, GroupsSameSource);
+
+	Groups.Append(MoveTemp(GroupsSameSource));
+	Groups.StableSort([](const FPjcDuplicateGroup& A, const FPjcDuplicateGroup& B)
 	{
-		FPlatformFileManager::Get().GetPlatformFile().IterateDirectoryRecursively(*InSearchPath, FindFoldersVisitor);
-	}
-	else
+		return A.SizeReclaimable > B.SizeReclaimable;
+	});
+}
+
+void UPjcSubsystem::GetFolders(const FString& InSearchPath, const bool bSearchRecursive, TArray<FString>& OutFolders)
+{
+	OutFolders.Empty();
+
+	TArray<FPjcDirectoryEntry> Files;
+	TArray<FPjcDirectoryEntry> Folders;
+	FPjcDirectoryWalker{bSearchRecursive}.Walk(InSearchPath, Files, Folders);
+
+	OutFolders.Reserve(Folders.Num());
+
+	for (auto& Folder : Folders)
 	{
-		FPlatformFileManager::Get().GetPlatformFile().IterateDirectory(*InSearchPath, FindFoldersVisitor);
+		OutFolders.Emplace(MoveTemp(Folder.Path));
 	}
 }
 
 void UPjcSubsystem::GetFoldersEmpty(TArray<FString>& Folders)
 {
-	TArray<FString> FoldersAll;
-	GetFolders(FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir()), true, FoldersAll);
+	const TArray<FPjcContentFolder>& FoldersAll = FPjcContentIndex::Get().GetFolders();
+
+	TArray<bool> FoldersEmptyFlags;
+	GetFoldersEmptyFlags(FoldersEmptyFlags);
 
 	Folders.Reset(FoldersAll.Num());
 
-	for (const auto& Folder : FoldersAll)
+	for (int32 FolderIndex = 0; FolderIndex < FoldersAll.Num(); ++FolderIndex)
 	{
-		if (FolderIsEmpty(Folder) && !FolderIsEngineGenerated(Folder) && !FolderIsExcluded(Folder))
+		const FPjcContentFolder& Folder = FoldersAll[FolderIndex];
+
+		// content folder itself is never reported as empty
+		if (Folder.ParentIndex == INDEX_NONE) continue;
+
+		// folders are sorted by path, so excluded subtree is skipped as whole instead of checking every folder in it
+		if (FolderIsExcluded(Folder.Path))
+		{
+			const FString SubtreePrefix = Folder.Path + TEXT("/");
+			while (FolderIndex + 1 < FoldersAll.Num() && FoldersAll[FolderIndex + 1].Path.StartsWith(SubtreePrefix))
+			{
+				++FolderIndex;
+			}
+
+			continue;
+		}
+
+		if (FoldersEmptyFlags[FolderIndex] && !FolderIsEngineGenerated(Folder.Path))
 		{
-			Folders.Emplace(Folder);
+			Folders.Emplace(Folder.Path);
 		}
 	}
 
@@ -741,130 +1043,229 @@ void UPjcSubsystem::GetFoldersEmpty(TArray<FString>& Folders)
 
 void UPjcSubsystem::DeleteAssetsUnused(const bool bShowSlowTask, const bool bShowEditorNotification)
 {
-	if (GetModuleAssetRegistry().Get().IsLoadingAssets())
+	if (!DeletionPrepare()) return;
+
+	TArray<FAssetData> AssetsUnused;
+	GetAssetsUnused(AssetsUnused);
+
+	if (AssetsUnused.Num() == 0)
 	{
-		UE_LOG(LogProjectCleaner, Warning, TEXT("Failed to delete unused assets, because AssetRegistry still discovering assets."));
-		UE_LOG(LogProjectCleaner, Warning, TEXT("Please wait until it finished adn then try again."));
+		UE_LOG(LogProjectCleaner, Warning, TEXT("The project currently contains no unused assets, thus there are no items to delete."));
 		return;
 	}
 
-	if (GEditor && !GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->CloseAllAssetEditors())
+	// whole deletion order is computed once, buckets are just consecutive slices of it
+	FPjcDeletionPlan DeletionPlan;
+	DeletionPlan.Build(AssetsUnused, PjcConstants::BucketSize);
+
+	DeletionExecute(DeletionPlan, bShowSlowTask, bShowEditorNotification);
+}
+
+bool UPjcSubsystem::DeleteAssetsUnusedResume(const bool bShowSlowTask, const bool bShowEditorNotification)
+{
+	TArray<FName> ObjectPaths;
+	int32 NumAssetsCommitted = 0;
+
+	if (!FPjcDeletionJournal::Read(ObjectPaths, NumAssetsCommitted))
 	{
-		UE_LOG(LogProjectCleaner, Warning, TEXT("Failed to delete unused assets because some editor windows are still open."));
-		UE_LOG(LogProjectCleaner, Warning, TEXT("Please try again, check the OutputLog for reasons why certain windows haven't closed, or try to manually close all editor windows."));
-		return;
+		UE_LOG(LogProjectCleaner, Warning, TEXT("There is no interrupted deletion to resume."));
+		return false;
 	}
 
-	TArray<FAssetData> Redirectors;
-	GetProjectRedirectors(Redirectors);
-	FixProjectRedirectors(Redirectors);
+	if (!DeletionPrepare()) return false;
 
-	if (ProjectHasRedirectors())
+	// project could change since interruption (new excluded, primary or indirectly used assets), so only assets that are still unused are resumed
+	TArray<FAssetData> AssetsUnused;
+	GetAssetsUnused(AssetsUnused);
+
+	TSet<FName> ObjectPathsUnused;
+	ObjectPathsUnused.Reserve(AssetsUnused.Num());
+	for (const auto& Asset : AssetsUnused)
 	{
-		UE_LOG(LogProjectCleaner, Warning, TEXT("Failed to delete unused assets because project contains redirectors that failed to fix."));
-		UE_LOG(LogProjectCleaner, Warning, TEXT("Please fix redirectors first manually and then try again."));
-		return;
+		ObjectPathsUnused.Add(Asset.ObjectPath);
 	}
 
-	if (!FEditorFileUtils::SaveDirtyPackages(true, true, true, false, false, false))
+	// assets of interrupted bucket could be deleted already, remaining ones must still exist and have no referencers outside of plan
+	TArray<FAssetData> AssetsRemaining;
+	TSet<FName> PackagesRemaining;
+	int32 NumAssetsMissing = 0;
+	int32 NumAssetsUsed = 0;
+
+	for (int32 Index = NumAssetsCommitted; Index < ObjectPaths.Num(); ++Index)
 	{
-		UE_LOG(LogProjectCleaner, Warning, TEXT("Failed to delete unused assets because project contains unsaved assets."));
-		UE_LOG(LogProjectCleaner, Warning, TEXT("Please save those assets and then try again. Check OutputLog for more information"));
-		return;
+		const FAssetData Asset = GetModuleAssetRegistry().Get().GetAssetByObjectPath(ObjectPaths[Index]);
+
+		if (!Asset.IsValid() || !FPackageName::DoesPackageExist(Asset.PackageName.ToString()))
+		{
+			++NumAssetsMissing;
+			continue;
+		}
+
+		if (!ObjectPathsUnused.Contains(Asset.ObjectPath))
+		{
+			++NumAssetsUsed;
+			UE_LOG(LogProjectCleaner, Warning, TEXT("Planned asset %s is no longer unused and will be kept"), *Asset.ObjectPath.ToString());
+			continue;
+		}
+
+		PackagesRemaining.Add(Asset.PackageName);
+		AssetsRemaining.Emplace(Asset);
 	}
 
-	TArray<FAssetData> AssetsUnused;
-	GetAssetsUnused(AssetsUnused);
+	bool bValid = true;
+	TArray<FName> Refs;
 
-	if (AssetsUnused.Num() == 0)
+	for (const auto& Package : PackagesRemaining)
 	{
-		UE_LOG(LogProjectCleaner, Warning, TEXT("The project currently contains no unused assets, thus there are no items to delete."));
-		return;
+		Refs.Reset();
+		GetModuleAssetRegistry().Get().GetReferencers(Package, Refs);
+
+		for (const auto& Ref : Refs)
+		{
+			if (PackagesRemaining.Contains(Ref) || !FPackageName::DoesPackageExist(Ref.ToString())) continue;
+
+			bValid = false;
+			UE_LOG(LogProjectCleaner, Error, TEXT("Planned package %s is referenced by %s, that is not planned for deletion"), *Package.ToString(), *Ref.ToString());
+		}
 	}
 
-	constexpr int32 BucketSize = PjcConstants::BucketSize;
-	const int32 NumAssetsTotal = AssetsUnused.Num();
-	int32 NumAssetsDeleted = 0;
+	if (!bValid)
+	{
+		UE_LOG(LogProjectCleaner, Error, TEXT("Interrupted deletion no longer matches project. Aborting, please scan project and delete unused assets again."));
+		return false;
+	}
 
-	TArray<FAssetData> Bucket;
-	TArray<UObject*> LoadedAssets;
-	LoadedAssets.Reserve(BucketSize);
-	Bucket.Reserve(BucketSize);
+	UE_LOG(
+		LogProjectCleaner,
+		Display,
+		TEXT("Resuming deletion: %d of %d assets were deleted, %d more were already removed, %d are used now, %d remaining"),
+		NumAssetsCommitted,
+		ObjectPaths.Num(),
+		NumAssetsMissing,
+		NumAssetsUsed,
+		AssetsRemaining.Num()
+	);
 
-	// Assets must be loaded first when deleting, which can cause a lot of unnecessary shader compilation work.
-	// Therefore, we disable shader compilation during this stage for faster deletion and then enable it afterwards.
-	ShaderCompilationDisable();
+	if (AssetsRemaining.Num() == 0)
+	{
+		FPjcDeletionJournal::Discard();
+		return true;
+	}
+
+	// remaining assets get new plan and journal, that replaces interrupted one
+	FPjcDeletionPlan DeletionPlan;
+	DeletionPlan.Build(AssetsRemaining, PjcConstants::BucketSize);
+
+	DeletionExecute(DeletionPlan, bShowSlowTask, bShowEditorNotification);
+
+	return true;
+}
+
+bool UPjcSubsystem::DeletionCanResume()
+{
+	return FPjcDeletionJournal::Exists();
+}
+
+bool UPjcSubsystem::DeleteAssetsUnusedDryRun(const FString& PlanFilePath, const bool bShowSlowTask)
+{
+	// plan is checked against same conditions as DeleteAssetsUnusedByPlan, otherwise it would be rejected only when executed
+	if (!DeletionCanStart()) return false;
+
+	if (ProjectHasRedirectors())
+	{
+		UE_LOG(LogProjectCleaner, Error, TEXT("Project contains redirectors. Fix them and make new deletion plan. Aborting."));
+		return false;
+	}
 
 	FScopedSlowTask SlowTask(
-		AssetsUnused.Num(),
-		FText::FromString(TEXT("Deleting unused assets...")),
+		1.0f,
+		FText::FromString(TEXT("Building deletion plan...")),
 		bShowSlowTask && GIsEditor && !IsRunningCommandlet()
 	);
 	SlowTask.MakeDialog(false, false);
+	SlowTask.EnterProgressFrame(1.0f);
 
-	bool bErrors = false;
-
-	while (AssetsUnused.Num() > 0)
-	{
-		BucketFill(AssetsUnused, Bucket, BucketSize);
+	TArray<FAssetData> AssetsUnused;
+	GetAssetsUnused(AssetsUnused);
 
-		if (Bucket.Num() == 0)
-		{
-			break;
-		}
+	FPjcDeletionPlan DeletionPlan;
+	DeletionPlan.Build(AssetsUnused, PjcConstants::BucketSize);
 
-		if (!BucketPrepare(Bucket, LoadedAssets))
-		{
-			bErrors = true;
-			UE_LOG(LogProjectCleaner, Error, TEXT("Failed to load some assets. Aborting."));
-			break;
-		}
+	const FString FilePath = PlanFilePath.IsEmpty() ? GetDeletionPlanFilePath() : FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), PlanFilePath);
 
-		NumAssetsDeleted += BucketDelete(LoadedAssets);
-		const FString ProgressMsg = FString::Printf(TEXT("Deleted %d of %d assets"), NumAssetsDeleted, NumAssetsTotal);
-		SlowTask.EnterProgressFrame(Bucket.Num(), FText::FromString(ProgressMsg));
+	UE_LOG(LogProjectCleaner, Display, TEXT("Deletion plan: %d assets in %d buckets, %s on disk"), DeletionPlan.GetNumAssets(), DeletionPlan.GetNumBuckets(), *FText::AsMemory(DeletionPlan.GetSizeTotal(), IEC).ToString());
+	UE_LOG(LogProjectCleaner, Display, TEXT("Deletion plan: %d folders affected, %d folders become empty"), DeletionPlan.GetFoldersAffected().Num(), DeletionPlan.GetFoldersEmptyPredicted().Num());
 
-		Bucket.Reset();
-		LoadedAssets.Reset();
+	for (const auto& Folder : DeletionPlan.GetFoldersEmptyPredicted())
+	{
+		UE_LOG(LogProjectCleaner, Display, TEXT("    %s"), *Folder);
 	}
 
-	const TSet<FName> EmptyPackages = GetModuleAssetRegistry().Get().GetCachedEmptyPackages();
-	TArray<UPackage*> AssetPackages;
-	for (const auto& EmptyPackage : EmptyPackages)
+	if (!DeletionPlan.Save(FilePath))
 	{
-		UPackage* Package = FindPackage(nullptr, *EmptyPackage.ToString());
-		if (Package && Package->IsValidLowLevel())
-		{
-			AssetPackages.Add(Package);
-		}
+		UE_LOG(LogProjectCleaner, Error, TEXT("Failed to save deletion plan to %s"), *FilePath);
+		return false;
 	}
 
-	if (AssetPackages.Num() > 0)
+	UE_LOG(LogProjectCleaner, Display, TEXT("Deletion plan saved to %s"), *FilePath);
+
+	return true;
+}
+
+bool UPjcSubsystem::DeleteAssetsUnusedByPlan(const FString& PlanFilePath, const bool bShowSlowTask, const bool bShowEditorNotification)
+{
+	const FString FilePath = PlanFilePath.IsEmpty() ? GetDeletionPlanFilePath() : FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), PlanFilePath);
+
+	FPjcDeletionPlan DeletionPlan;
+	if (!DeletionPlan.Load(FilePath))
 	{
-		ObjectTools::CleanupAfterSuccessfulDelete(AssetPackages);
+		UE_LOG(LogProjectCleaner, Error, TEXT("Failed to load deletion plan %s. Aborting."), *FilePath);
+		return false;
 	}
 
-	ShaderCompilationEnable();
+	// nothing is fixed or saved before plan is verified, as that would change project plan was made for
+	if (!DeletionCanStart()) return false;
 
-	const FString Msg = FString::Printf(TEXT("Deleted %d of %d assets"), NumAssetsDeleted, NumAssetsTotal);
-	UE_LOG(LogProjectCleaner, Display, TEXT("%s"), *Msg);
+	if (ProjectHasRedirectors())
+	{
+		UE_LOG(LogProjectCleaner, Error, TEXT("Project contains redirectors. Fix them and make new deletion plan. Aborting."));
+		return false;
+	}
 
-	if (bErrors)
+	TArray<UPackage*> PackagesDirty;
+	FEditorFileUtils::GetDirtyContentPackages(PackagesDirty);
+
+	if (PackagesDirty.Num() > 0)
 	{
-		UE_LOG(LogProjectCleaner, Error, TEXT("There very some errors while deleting assets. Please check OutputLog for more information."));
+		UE_LOG(LogProjectCleaner, Error, TEXT("Project contains %d unsaved assets. Save them and make new deletion plan. Aborting."), PackagesDirty.Num());
+		return false;
 	}
 
-	if (bShowEditorNotification && GEditor)
+	TArray<FAssetData> AssetsUnused;
+	GetAssetsUnused(AssetsUnused);
+
+	// plan is executed only if project still looks exactly like it did when plan was made
+	TArray<FString> Errors;
+	if (!DeletionPlan.Verify(AssetsUnused, Errors))
 	{
-		if (NumAssetsDeleted == NumAssetsTotal)
-		{
-			ShowNotification(Msg, SNotificationItem::CS_Success, 3.0f);
-		}
-		else
+		for (const auto& Error : Errors)
 		{
-			ShowNotificationWithOutputLog(Msg, SNotificationItem::CS_Fail, 5.0f);
+			UE_LOG(LogProjectCleaner, Error, TEXT("%s"), *Error);
 		}
+
+		UE_LOG(LogProjectCleaner, Error, TEXT("Deletion plan %s is outdated. Aborting."), *FilePath);
+		return false;
+	}
+
+	if (DeletionPlan.GetNumAssets() == 0)
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Deletion plan contains no assets, thus there are no items to delete."));
+		return true;
 	}
+
+	DeletionExecute(DeletionPlan, bShowSlowTask, bShowEditorNotification);
+
+	return true;
 }
 
 void UPjcSubsystem::DeleteFoldersEmpty(const bool bShowSlowTask, const bool bShowEditorNotification)
@@ -915,6 +1316,8 @@ void UPjcSubsystem::DeleteFoldersEmpty(const bool bShowSlowTask, const bool bSho
 		GetModuleAssetRegistry().Get().RemovePath(PathConvertToRelative(Folder));
 	}
 
+	FPjcContentIndex::MarkDirty();
+
 	const FString Msg = FString::Printf(TEXT("Deleted %d of %d empty folders"), NumFoldersDeleted, NumFoldersTotal);
 	UE_LOG(LogProjectCleaner, Display, TEXT("%s"), *Msg);
 
@@ -947,30 +1350,9 @@ void UPjcSubsystem::DeleteFilesExternal(const bool bShowSlowTask, const bool bSh
 		return;
 	}
 
-	FScopedSlowTask SlowTask(
-		FilesExternalFiltered.Num(),
-		FText::FromString(TEXT("Deleting external files ...")),
-		bShowSlowTask && GIsEditor && !IsRunningCommandlet()
-	);
-	SlowTask.MakeDialog(false, false);
-
-	bool bErrors = false;
-
 	const int32 NumFilesTotal = FilesExternalFiltered.Num();
-	int32 NumFilesDeleted = 0;
-
-	for (const auto& File : FilesExternalFiltered)
-	{
-		SlowTask.EnterProgressFrame(1.0f, FText::FromString(File));
-
-		if (!IFileManager::Get().Delete(*File, true))
-		{
-			bErrors = true;
-			UE_LOG(LogProjectCleaner, Error, TEXT("Failed to delete file: %s"), *File);
-		}
-
-		++NumFilesDeleted;
-	}
+	const int32 NumFilesDeleted = FilesDelete(FilesExternalFiltered, TEXT("Deleting external files ..."), bShowSlowTask);
+	const bool bErrors = NumFilesDeleted != NumFilesTotal;
 
 	const FString Msg = FString::Printf(TEXT("Deleted %d of %d external files"), NumFilesDeleted, NumFilesTotal);
 	UE_LOG(LogProjectCleaner, Display, TEXT("%s"), *Msg);
@@ -1004,30 +1386,9 @@ void UPjcSubsystem::DeleteFilesCorrupted(const bool bShowSlowTask, const bool bS
 		return;
 	}
 
-	FScopedSlowTask SlowTask(
-		FilesCorrupted.Num(),
-		FText::FromString(TEXT("Deleting corrupted asset files ...")),
-		bShowSlowTask && GIsEditor && !IsRunningCommandlet()
-	);
-	SlowTask.MakeDialog(false, false);
-
-	bool bErrors = false;
-
 	const int32 NumFilesTotal = FilesCorrupted.Num();
-	int32 NumFilesDeleted = 0;
-
-	for (const auto& File : FilesCorrupted)
-	{
-		SlowTask.EnterProgressFrame(1.0f, FText::FromString(File));
-
-		if (!IFileManager::Get().Delete(*File, true))
-		{
-			bErrors = true;
-			UE_LOG(LogProjectCleaner, Error, TEXT("Failed to delete file: %s"), *File);
-		}
-
-		++NumFilesDeleted;
-	}
+	const int32 NumFilesDeleted = FilesDelete(FilesCorrupted, TEXT("Deleting corrupted asset files ..."), bShowSlowTask);
+	const bool bErrors = NumFilesDeleted != NumFilesTotal;
 
 	const FString Msg = FString::Printf(TEXT("Deleted %d of %d corrupted files"), NumFilesDeleted, NumFilesTotal);
 	UE_LOG(LogProjectCleaner, Display, TEXT("%s"), *Msg);
@@ -1050,202 +1411,346 @@ void UPjcSubsystem::DeleteFilesCorrupted(const bool bShowSlowTask, const bool bS
 	}
 }
 
-void UPjcSubsystem::GetProjectRedirectors(TArray<FAssetData>& Redirectors)
-{
-	FARFilter Filter;
-	Filter.bRecursivePaths = true;
-	Filter.PackagePaths.Emplace(PjcConstants::PathRoot);
-	Filter.ClassNames.Emplace(UObjectRedirector::StaticClass()->GetFName());
-
-	Redirectors.Reset();
-	GetModuleAssetRegistry().Get().GetAssets(Filter, Redirectors);
-}
-
-bool UPjcSubsystem::ProjectHasRedirectors()
+FString UPjcSubsystem::QuarantineUnused(const bool bShowSlowTask, const bool bShowEditorNotification)
 {
-	TArray<FAssetData> Redirectors;
-	GetProjectRedirectors(Redirectors);
+	if (!DeletionPrepare()) return {};
 
-	return Redirectors.Num() > 0;
-}
+	TArray<FAssetData> AssetsUnused;
+	GetAssetsUnused(AssetsUnused);
 
-void UPjcSubsystem::FixProjectRedirectors(const TArray<FAssetData>& Redirectors, const bool bShowSlowTask)
-{
-	if (Redirectors.Num() == 0) return;
+	TSet<FName> Packages;
+	TSet<FName> PackagesKept;
+	TArray<FName> Stack;
 
-	FScopedSlowTask SlowTask{
-		static_cast<float>(Redirectors.Num()),
-		FText::FromString(TEXT("Fixing redirectors...")),
-		bShowSlowTask && GIsEditor && !IsRunningCommandlet()
-	};
-	SlowTask.MakeDialog(false, false);
+	for (const auto& Asset : AssetsUnused)
+	{
+		bool bVisited = false;
+		Packages.Add(Asset.PackageName, &bVisited);
+		if (bVisited) continue;
 
-	TArray<UObjectRedirector*> RedirectorObjects;
-	RedirectorObjects.Reserve(Redirectors.Num());
+		// package in memory still points to its file and could be saved back, so it stays in place
+		if (FindPackage(nullptr, *Asset.PackageName.ToString()))
+		{
+			PackagesKept.Add(Asset.PackageName);
+			Stack.Add(Asset.PackageName);
+		}
+	}
 
-	for (const auto& Redirector : Redirectors)
+	// unused packages imported by kept ones stay in place too, otherwise kept packages are left with broken imports
+	TArray<FName> Deps;
+	while (Stack.Num() > 0)
 	{
-		SlowTask.EnterProgressFrame(1.0f, FText::FromString(Redirector.GetFullName()));
+		const FName CurrentPackageName = Stack.Pop(false);
+		Deps.Reset();
 
-		UObjectRedirector* RedirectorObject = CastChecked<UObjectRedirector>(Redirector.GetAsset());
-		if (!RedirectorObject) continue;
+		GetModuleAssetRegistry().Get().GetDependencies(CurrentPackageName, Deps);
 
-		RedirectorObjects.Emplace(RedirectorObject);
-	}
+		for (const auto& Dep : Deps)
+		{
+			if (!Packages.Contains(Dep)) continue;
 
-	GetModuleAssetTools().Get().FixupReferencers(RedirectorObjects, false);
-}
+			bool bIsAlreadyInSet = false;
+			PackagesKept.Add(Dep, &bIsAlreadyInSet);
+			if (!bIsAlreadyInSet)
+			{
+				Stack.Add(Dep);
+			}
+		}
+	}
 
-bool UPjcSubsystem::EditorIsInPlayMode()
-{
-	return (GEditor && GEditor->PlayWorld) || GIsPlayInEditorWorld;
-}
+	TArray<FString> Files;
+	for (const auto& Package : Packages)
+	{
+		if (PackagesKept.Contains(Package)) continue;
 
-bool UPjcSubsystem::AssetIsBlueprint(const FAssetData& InAsset)
-{
-	if (!InAsset.IsValid()) return false;
+		PackageGetFiles(Package, Files);
+	}
 
-	const UClass* AssetClass = InAsset.GetClass();
-	if (!AssetClass) return false;
+	TArray<FString> FilesExternal;
+	GetFilesExternalFiltered(FilesExternal);
+	Files.Append(FilesExternal);
 
-	return AssetClass->IsChildOf(UBlueprint::StaticClass());
-}
+	if (Files.Num() == 0)
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("The project currently contains no unused assets or external files, thus there are no items to quarantine."));
+		return {};
+	}
 
-bool UPjcSubsystem::AssetIsExtReferenced(const FAssetData& InAsset)
-{
-	if (!InAsset.IsValid()) return false;
+	FString QuarantineId;
+	const int32 NumFilesMoved = FPjcQuarantine::Move(Files, QuarantineId, bShowSlowTask);
 
-	TArray<FName> Refs;
-	GetModuleAssetRegistry().Get().GetReferencers(InAsset.PackageName, Refs);
+	if (NumFilesMoved == 0)
+	{
+		FPjcQuarantine::Purge(QuarantineId);
+	}
 
-	return Refs.ContainsByPredicate([](const FName& Ref)
+	// moved packages are removed from asset registry in single synchronous scan, so scan right after move does not see them
+	TArray<FString> PackageFilesMoved;
+	for (const auto& File : Files)
 	{
-		return !Ref.ToString().StartsWith(PjcConstants::PathRoot.ToString());
-	});
-}
+		if (!PjcConstants::PackageFileExtensions.Contains(FPaths::GetExtension(File).ToLower())) continue;
+		if (IFileManager::Get().FileExists(*File)) continue;
 
-bool UPjcSubsystem::AssetIsCircular(const FAssetData& InAsset)
-{
-	if (!InAsset.IsValid()) return false;
+		PackageFilesMoved.Add(File);
+	}
 
-	TArray<FName> Refs;
-	TArray<FName> Deps;
+	if (PackageFilesMoved.Num() > 0)
+	{
+		GetModuleAssetRegistry().Get().ScanModifiedAssetFiles(PackageFilesMoved);
+	}
 
-	GetModuleAssetRegistry().Get().GetReferencers(InAsset.PackageName, Refs);
-	GetModuleAssetRegistry().Get().GetDependencies(InAsset.PackageName, Deps);
+	FPjcContentIndex::MarkDirty();
+	FPjcContentIndex::OnContentChanged().Broadcast();
 
-	for (const auto& Ref : Refs)
+	if (PackagesKept.Num() > 0)
 	{
-		if (Deps.Contains(Ref))
+		UE_LOG(LogProjectCleaner, Warning, TEXT("%d unused packages are loaded in memory or used by loaded ones and were kept in place. Restart editor and try again to quarantine them."), PackagesKept.Num());
+	}
+
+	const FString Msg = FString::Printf(TEXT("Moved %d of %d files to quarantine %s"), NumFilesMoved, Files.Num(), *QuarantineId);
+	UE_LOG(LogProjectCleaner, Display, TEXT("%s"), *Msg);
+
+	if (bShowEditorNotification && GEditor)
+	{
+		if (NumFilesMoved == Files.Num())
 		{
-			return true;
+			ShowNotification(Msg, SNotificationItem::CS_Success, 3.0f);
+		}
+		else
+		{
+			ShowNotificationWithOutputLog(Msg, SNotificationItem::CS_Fail, 5.0f);
 		}
 	}
 
-	return false;
+	return NumFilesMoved > 0 ? QuarantineId : FString{};
 }
 
-FString UPjcSubsystem::PathNormalize(const FString& InPath)
+bool UPjcSubsystem::QuarantineRestore(const FString& QuarantineId, const bool bShowSlowTask, const bool bShowEditorNotification)
 {
-	if (InPath.IsEmpty()) return {};
+	FString Id = QuarantineId;
 
-	// Ensure the path dont starts with a slash or a disk drive letter
-	if (!(InPath.StartsWith(TEXT("/")) || InPath.StartsWith(TEXT("\\")) || (InPath.Len() > 2 && InPath[1] == ':')))
+	if (Id.IsEmpty())
 	{
-		return {};
+		TArray<FString> QuarantineIds;
+		FPjcQuarantine::GetQuarantineIds(QuarantineIds);
+
+		if (QuarantineIds.Num() == 0)
+		{
+			UE_LOG(LogProjectCleaner, Warning, TEXT("There is no quarantine to restore."));
+			return false;
+		}
+
+		Id = QuarantineIds.Last();
 	}
 
-	FString Path = FPaths::ConvertRelativePathToFull(InPath).TrimStartAndEnd();
-	FPaths::RemoveDuplicateSlashes(Path);
+	TArray<FString> FilesRestored;
+	const bool bRestored = FPjcQuarantine::Restore(Id, FilesRestored, bShowSlowTask);
 
-	// Collapse any ".." or "." references in the path
-	FPaths::CollapseRelativeDirectories(Path);
+	// restored packages are added back to asset registry in single scan
+	TArray<FString> PackageFilesRestored;
+	for (const auto& File : FilesRestored)
+	{
+		if (!PjcConstants::PackageFileExtensions.Contains(FPaths::GetExtension(File).ToLower())) continue;
+
+		PackageFilesRestored.Add(File);
+	}
 
-	if (FPaths::GetExtension(Path).IsEmpty())
+	if (PackageFilesRestored.Num() > 0)
 	{
-		FPaths::NormalizeDirectoryName(Path);
+		GetModuleAssetRegistry().Get().ScanFilesSynchronous(PackageFilesRestored, true);
 	}
-	else
+
+	FPjcContentIndex::MarkDirty();
+	FPjcContentIndex::OnContentChanged().Broadcast();
+
+	const FString Msg = FString::Printf(TEXT("Restored %d files from quarantine %s"), FilesRestored.Num(), *Id);
+	UE_LOG(LogProjectCleaner, Display, TEXT("%s"), *Msg);
+
+	if (!bRestored)
 	{
-		FPaths::NormalizeFilename(Path);
+		UE_LOG(LogProjectCleaner, Error, TEXT("Failed to restore some files. Quarantine %s is kept, please check OutputLog for more information"), *Id);
 	}
 
-	// Ensure the path does not end with a trailing slash
-	if (Path.EndsWith(TEXT("/")) || Path.EndsWith(TEXT("\\")))
+	if (bShowEditorNotification && GEditor)
 	{
-		Path = Path.LeftChop(1);
+		if (bRestored)
+		{
+			ShowNotification(Msg, SNotificationItem::CS_Success, 3.0f);
+		}
+		else
+		{
+			ShowNotificationWithOutputLog(Msg, SNotificationItem::CS_Fail, 5.0f);
+		}
 	}
 
-	return Path;
+	return bRestored;
 }
 
-FString UPjcSubsystem::PathConvertToAbsolute(const FString& InPath)
+bool UPjcSubsystem::QuarantinePurge(const FString& QuarantineId)
 {
-	const FString PathNormalized = PathNormalize(InPath);
-	const FString PathProjectContent = FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir()).LeftChop(1);
+	TArray<FString> QuarantineIds;
+
+	if (QuarantineId.IsEmpty())
+	{
+		FPjcQuarantine::GetQuarantineIds(QuarantineIds);
+	}
+	else
+	{
+		QuarantineIds.Add(QuarantineId);
+	}
+
+	bool bErrors = false;
 
-	if (PathNormalized.IsEmpty()) return {};
-	if (PathNormalized.StartsWith(PathProjectContent)) return PathNormalized;
-	if (PathNormalized.StartsWith(PjcConstants::PathRoot.ToString()))
+	for (const auto& Id : QuarantineIds)
 	{
-		FString Path = PathNormalized;
-		Path.RemoveFromStart(PjcConstants::PathRoot.ToString());
+		if (FPjcQuarantine::Purge(Id))
+		{
+			UE_LOG(LogProjectCleaner, Display, TEXT("Purged quarantine %s"), *Id);
+			continue;
+		}
 
-		return Path.IsEmpty() ? PathProjectContent : PathProjectContent / Path;
+		bErrors = true;
+		UE_LOG(LogProjectCleaner, Error, TEXT("Failed to purge quarantine %s"), *Id);
 	}
 
-	return {};
+	return !bErrors;
 }
 
-FString UPjcSubsystem::PathConvertToRelative(const FString& InPath)
+void UPjcSubsystem::GetQuarantineIds(TArray<FString>& QuarantineIds)
 {
-	const FString PathNormalized = PathNormalize(InPath);
-	const FString PathProjectContent = FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir()).LeftChop(1);
+	FPjcQuarantine::GetQuarantineIds(QuarantineIds);
+}
 
-	if (PathNormalized.IsEmpty()) return {};
-	if (PathNormalized.StartsWith(PjcConstants::PathRoot.ToString())) return PathNormalized;
-	if (PathNormalized.StartsWith(PathProjectContent))
-	{
-		FString Path = PathNormalized;
-		Path.RemoveFromStart(PathProjectContent);
+void UPjcSubsystem::GetProjectRedirectors(TArray<FAssetData>& Redirectors)
+{
+	FARFilter Filter;
+	Filter.bRecursivePaths = true;
+	Filter.PackagePaths.Emplace(PjcConstants::PathRoot);
+	Filter.ClassNames.Emplace(UObjectRedirector::StaticClass()->GetFName());
 
-		return Path.IsEmpty() ? PjcConstants::PathRoot.ToString() : PjcConstants::PathRoot.ToString() / Path;
-	}
+	Redirectors.Reset();
+	GetModuleAssetRegistry().Get().GetAssets(Filter, Redirectors);
+}
 
-	return {};
+bool UPjcSubsystem::ProjectHasRedirectors()
+{
+	TArray<FAssetData> Redirectors;
+	GetProjectRedirectors(Redirectors);
+
+	return Redirectors.Num() > 0;
 }
 
-FString UPjcSubsystem::PathConvertToObjectPath(const FString& InPath)
+void UPjcSubsystem::FixProjectRedirectors(const TArray<FAssetData>& Redirectors, const bool bShowSlowTask)
 {
-	if (FPaths::FileExists(InPath))
+	if (Redirectors.Num() == 0) return;
+
+	FScopedSlowTask SlowTask{
+		static_cast<float>(Redirectors.Num()),
+		FText::FromString(TEXT("Fixing redirectors...")),
+		bShowSlowTask && GIsEditor && !IsRunningCommandlet()
+	};
+	SlowTask.MakeDialog(false, false);
+
+	TArray<UObjectRedirector*> RedirectorObjects;
+	RedirectorObjects.Reserve(Redirectors.Num());
+
+	for (const auto& Redirector : Redirectors)
 	{
-		const FString FileName = FPaths::GetBaseFilename(InPath);
-		const FString AssetPath = PathConvertToRelative(FPaths::GetPath(InPath));
+		SlowTask.EnterProgressFrame(1.0f, FText::FromString(Redirector.GetFullName()));
+
+		UObjectRedirector* RedirectorObject = CastChecked<UObjectRedirector>(Redirector.GetAsset());
+		if (!RedirectorObject) continue;
 
-		return FString::Printf(TEXT("%s/%s.%s"), *AssetPath, *FileName, *FileName);
+		RedirectorObjects.Emplace(RedirectorObject);
 	}
 
-	FString ObjectPath = FPackageName::ExportTextPathToObjectPath(InPath);
-	ObjectPath.RemoveFromEnd(TEXT("_C")); // we should remove _C prefix if its blueprint asset
+	GetModuleAssetTools().Get().FixupReferencers(RedirectorObjects, false);
+}
 
-	if (!ObjectPath.StartsWith(PjcConstants::PathRoot.ToString())) return {};
+bool UPjcSubsystem::EditorIsInPlayMode()
+{
+	return (GEditor && GEditor->PlayWorld) || GIsPlayInEditorWorld;
+}
 
-	TArray<FString> Parts;
-	ObjectPath.ParseIntoArray(Parts, TEXT("/"), true);
+bool UPjcSubsystem::AssetIsBlueprint(const FAssetData& InAsset)
+{
+	if (!InAsset.IsValid()) return false;
 
-	if (Parts.Num() > 0)
+	const UClass* AssetClass = InAsset.GetClass();
+	if (!AssetClass) return false;
+
+	return AssetClass->IsChildOf(UBlueprint::StaticClass());
+}
+
+bool UPjcSubsystem::AssetIsExtReferenced(const FAssetData& InAsset)
+{
+	if (!InAsset.IsValid()) return false;
+
+	TArray<FName> Refs;
+	GetModuleAssetRegistry().Get().GetReferencers(InAsset.PackageName, Refs);
+
+	return Refs.ContainsByPredicate([](const FName& Ref)
 	{
-		FString Left;
-		FString Right;
-		Parts.Last().Split(TEXT("."), &Left, &Right);
+		return !Ref.ToString().StartsWith(PjcConstants::PathRoot.ToString());
+	});
+}
+
+bool UPjcSubsystem::AssetIsCircular(const FAssetData& InAsset)
+{
+	if (!InAsset.IsValid()) return false;
+
+	TArray<FName> Refs;
+	TArray<FName> Deps;
 
-		if (!Left.IsEmpty() && !Right.IsEmpty() && Left.Equals(*Right))
+	GetModuleAssetRegistry().Get().GetReferencers(InAsset.PackageName, Refs);
+	GetModuleAssetRegistry().Get().GetDependencies(InAsset.PackageName, Deps);
+
+	for (const auto& Ref : Refs)
+	{
+		if (Deps.Contains(Ref))
 		{
-			return ObjectPath;
+			return true;
 		}
 	}
 
-	return {};
+	return false;
+}
+
+FString UPjcSubsystem::PathNormalize(const FString& InPath)
+{
+	TStringBuilder<256> Path;
+	return FPjcPaths::Normalize(InPath, Path) ? FString{Path.Len(), Path.GetData()} : FString{};
+}
+
+FString UPjcSubsystem::PathConvertToAbsolute(const FString& InPath)
+{
+	TStringBuilder<256> Path;
+	return FPjcPaths::ToAbsolute(InPath, Path) ? FString{Path.Len(), Path.GetData()} : FString{};
+}
+
+FString UPjcSubsystem::PathConvertToRelative(const FString& InPath)
+{
+	TStringBuilder<256> Path;
+	return FPjcPaths::ToRelative(InPath, Path) ? FString{Path.Len(), Path.GetData()} : FString{};
+}
+
+FString UPjcSubsystem::PathConvertToObjectPath(const FString& InPath)
+{
+	TStringBuilder<256> Path;
+
+	// package files in Content folder are converted by name, without checking file system
+	if (FPjcPaths::IsUnderContentDir(InPath) && !FPaths::GetExtension(InPath).IsEmpty())
+	{
+		return FPjcPaths::FileToObjectPath(InPath, Path) ? FString{Path.Len(), Path.GetData()} : FString{};
+	}
+
+	return FPjcPaths::ExportTextToObjectPath(InPath, Path) ? FString{Path.Len(), Path.GetData()} : FString{};
+}
+
+FString UPjcSubsystem::PathConvertExportTextToObjectPath(const FString& InPath)
+{
+	TStringBuilder<256> Path;
+	return FPjcPaths::ExportTextToObjectPath(InPath, Path) ? FString{Path.Len(), Path.GetData()} : FString{};
 }
 
 int64 UPjcSubsystem::GetAssetSize(const FAssetData& InAsset)
@@ -1277,9 +1782,16 @@ int64 UPjcSubsystem::GetAssetsTotalSize(const TArray<FAssetData>& InAssets)
 
 int64 UPjcSubsystem::GetFileSize(const FString& InFile)
 {
-	if (InFile.IsEmpty() || !FPaths::FileExists(InFile)) return 0;
+	if (InFile.IsEmpty()) return 0;
 
-	return IFileManager::Get().FileSize(*InFile);
+	// files in Content folder are already in content table, others require stat call
+	const FPjcContentFile* ContentFile = FPjcContentIndex::Get().FindFile(InFile);
+	if (ContentFile) return ContentFile->Size;
+
+	const FFileStatData StatData = IFileManager::Get().GetStatData(*InFile);
+	if (!StatData.bIsValid || StatData.bIsDirectory) return 0;
+
+	return StatData.FileSize;
 }
 
 int64 UPjcSubsystem::GetFilesTotalSize(const TArray<FString>& Files)
@@ -1288,9 +1800,7 @@ int64 UPjcSubsystem::GetFilesTotalSize(const TArray<FString>& Files)
 
 	for (const auto& File : Files)
 	{
-		if (File.IsEmpty() || !FPaths::FileExists(File)) continue;
-
-		Size += IFileManager::Get().FileSize(*File);
+		Size += GetFileSize(File);
 	}
 
 	return Size;
@@ -1310,6 +1820,96 @@ FName UPjcSubsystem::GetAssetExactClassName(const FAssetData& InAsset)
 	return InAsset.AssetClass;
 }
 
+void UPjcSubsystem::GetFoldersEmptyFlags(TArray<bool>& OutFlags)
+{
+	const TArray<FPjcContentFolder>& Folders = FPjcContentIndex::Get().GetFolders();
+
+	OutFlags.SetNumUninitialized(Folders.Num());
+
+	for (int32 FolderIndex = 0; FolderIndex < Folders.Num(); ++FolderIndex)
+	{
+		OutFlags[FolderIndex] = Folders[FolderIndex].bEmpty;
+	}
+
+	// assets that exist only in memory have no files on disk yet, so folders that contain them and all their parents are not empty.
+	// parent walk stops at first already non empty folder, so every folder is cleared at most once
+	TStringBuilder<256> PathRel;
+	for (int32 FolderIndex = 0; FolderIndex < Folders.Num(); ++FolderIndex)
+	{
+		if (!OutFlags[FolderIndex]) continue;
+		if (!FPjcPaths::ToRelative(Folders[FolderIndex].Path, PathRel)) continue;
+		if (!GetModuleAssetRegistry().Get().HasAssets(FName{PathRel.Len(), PathRel.GetData()}, false)) continue;
+
+		for (int32 Index = FolderIndex; Index != INDEX_NONE && OutFlags[Index]; Index = Folders[Index].ParentIndex)
+		{
+			OutFlags[Index] = false;
+		}
+	}
+}
+
+void UPjcSubsystem::GetFoldersDiskUsage(const TArray<FAssetData>& InAssetsUnused, TArray<FPjcFolderDiskUsage>& OutUsage)
+{
+	const FPjcContentIndex& ContentIndex = FPjcContentIndex::Get();
+	const TArray<FPjcContentFile>& Files = ContentIndex.GetFiles();
+	const TArray<FPjcContentFolder>& Folders = ContentIndex.GetFolders();
+	const TSet<int32> PackageExtIds = ContentIndex.GetExtIds(PjcConstants::PackageFileExtensions);
+	const TSet<int32> SidecarExtIds = ContentIndex.GetExtIds(PjcConstants::SidecarFileExtensions);
+
+	// unused packages are resolved to content table files once, so files are classified without any path conversion
+	TBitArray<> FilesUnused{false, Files.Num()};
+	TStringBuilder<256> PackageFile;
+
+	for (const auto& Asset : InAssetsUnused)
+	{
+		if (!FPjcPaths::ToAbsolute(Asset.PackageName.ToString(), PackageFile)) continue;
+
+		const int32 PackageFileLen = PackageFile.Len();
+		for (const auto& Ext : PjcConstants::PackageFileExtensions)
+		{
+			PackageFile.RemoveSuffix(PackageFile.Len() - PackageFileLen);
+			PackageFile << TEXT(".") << *Ext;
+
+			const FPjcContentFile* File = ContentIndex.FindFile(FString{PackageFile.Len(), PackageFile.GetData()});
+			if (!File) continue;
+
+			FilesUnused[static_cast<int32>(File - Files.GetData())] = true;
+		}
+	}
+
+	OutUsage.Reset();
+	OutUsage.SetNum(Folders.Num());
+
+	for (int32 FileIndex = 0; FileIndex < Files.Num(); ++FileIndex)
+	{
+		const FPjcContentFile& File = Files[FileIndex];
+		if (File.FolderIndex == INDEX_NONE) continue;
+
+		FPjcFolderDiskUsage& Usage = OutUsage[File.FolderIndex];
+
+		if (PackageExtIds.Contains(File.ExtId))
+		{
+			(FilesUnused[FileIndex] ? Usage.SizeUnused : Usage.SizeUsed) += File.Size;
+		}
+		else if (SidecarExtIds.Contains(File.ExtId))
+		{
+			Usage.SizeSidecar += File.Size;
+		}
+		else
+		{
+			Usage.SizeExternal += File.Size;
+		}
+	}
+
+	// children always have greater index than their parent, so reverse order finishes every folder before its parent
+	for (int32 FolderIndex = Folders.Num() - 1; FolderIndex > 0; --FolderIndex)
+	{
+		const int32 ParentIndex = Folders[FolderIndex].ParentIndex;
+		if (ParentIndex == INDEX_NONE) continue;
+
+		OutUsage[ParentIndex].Add(OutUsage[FolderIndex]);
+	}
+}
+
 bool UPjcSubsystem::FolderIsEmpty(const FString& InPath)
 {
 	if (InPath.IsEmpty()) return false;
@@ -1323,6 +1923,9 @@ bool UPjcSubsystem::FolderIsEmpty(const FString& InPath)
 	const FString PathAbs = PathConvertToAbsolute(InPath);
 	if (PathAbs.IsEmpty()) return false;
 
+	const FPjcContentFolder* Folder = FPjcContentIndex::Get().FindFolder(PathAbs);
+	if (Folder) return Folder->bEmpty;
+
 	TArray<FString> Files;
 	IFileManager::Get().FindFilesRecursive(Files, *PathAbs, TEXT("*"), true, false);
 
@@ -1334,15 +1937,15 @@ bool UPjcSubsystem::FolderIsExcluded(const FString& InPath)
 	const UPjcAssetExcludeSettings* EditorAssetExcludeSettings = GetDefault<UPjcAssetExcludeSettings>();
 	if (!EditorAssetExcludeSettings) return false;
 
-	const FString PathRel = PathConvertToRelative(InPath);
-	if (PathRel.IsEmpty()) return false;
+	TStringBuilder<256> PathRel;
+	if (!FPjcPaths::ToRelative(InPath, PathRel)) return false;
 
+	TStringBuilder<256> ExcludedPathRel;
 	for (const auto& ExcludedPath : EditorAssetExcludeSettings->ExcludedFolders)
 	{
-		const FString ExcludedPathRel = PathConvertToRelative(ExcludedPath.Path);
-		if (ExcludedPathRel.IsEmpty()) continue;
+		if (!FPjcPaths::ToRelative(ExcludedPath.Path, ExcludedPathRel)) continue;
 
-		if (PathRel.StartsWith(ExcludedPathRel))
+		if (PathRel.ToView().StartsWith(ExcludedPathRel.ToView()))
 		{
 			return true;
 		}
@@ -1369,15 +1972,31 @@ bool UPjcSubsystem::FolderIsEngineGenerated(const FString& InPath)
 
 void UPjcSubsystem::GetSourceAndConfigFiles(TSet<FString>& Files)
 {
+	const FString DirPrj = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir());
 	const FString DirSrc = FPaths::ConvertRelativePathToFull(FPaths::GameSourceDir());
 	const FString DirCfg = FPaths::ConvertRelativePathToFull(FPaths::ProjectConfigDir());
+	const FString DirCnt = FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir());
 	const FString DirPlg = FPaths::ConvertRelativePathToFull(FPaths::ProjectPluginsDir());
 
+	// source folders can contain editor scripts and datatable sources along with code
+	TSet<FString> SourceExtensions;
+	SourceExtensions.Append(PjcConstants::SourceFileExtensions);
+	SourceExtensions.Append(PjcConstants::ScriptFileExtensions);
+	SourceExtensions.Append(PjcConstants::DataFileExtensions);
+
+	TSet<FString> ContentExtensions;
+	ContentExtensions.Append(PjcConstants::ScriptFileExtensions);
+	ContentExtensions.Append(PjcConstants::DataFileExtensions);
+
 	TArray<FString> SourceFiles;
 	TArray<FString> ConfigFiles;
+	TArray<FString> ContentFiles;
+	TArray<FString> ProjectFiles;
 
-	GetFilesByExt(DirSrc, true, false, PjcConstants::SourceFileExtensions, SourceFiles);
+	GetFilesByExt(DirPrj, false, false, PjcConstants::ProjectFileExtensions, ProjectFiles);
+	GetFilesByExt(DirSrc, true, false, SourceExtensions, SourceFiles);
 	GetFilesByExt(DirCfg, true, false, PjcConstants::ConfigFileExtensions, ConfigFiles);
+	GetFilesByExt(DirCnt, true, false, ContentExtensions, ContentFiles);
 
 	TArray<FString> InstalledPlugins;
 	GetFolders(DirPlg, false, InstalledPlugins);
@@ -1389,7 +2008,12 @@ void UPjcSubsystem::GetSourceAndConfigFiles(TSet<FString>& Files)
 		// ignore ProjectCleaner plugin
 		if (InstalledPlugin.Equals(ProjectCleanerPluginPath)) continue;
 
-		GetFilesByExt(InstalledPlugin / TEXT("Source"), true, false, PjcConstants::SourceFileExtensions, PluginFiles);
+		GetFilesByExt(InstalledPlugin, false, false, PjcConstants::ProjectFileExtensions, PluginFiles);
+		ProjectFiles.Append(PluginFiles);
+
+		PluginFiles.Reset();
+
+		GetFilesByExt(InstalledPlugin / TEXT("Source"), true, false, SourceExtensions, PluginFiles);
 		SourceFiles.Append(PluginFiles);
 
 		PluginFiles.Reset();
@@ -1398,11 +2022,18 @@ void UPjcSubsystem::GetSourceAndConfigFiles(TSet<FString>& Files)
 		ConfigFiles.Append(PluginFiles);
 
 		PluginFiles.Reset();
+
+		GetFilesByExt(InstalledPlugin / TEXT("Content"), true, false, ContentExtensions, PluginFiles);
+		ContentFiles.Append(PluginFiles);
+
+		PluginFiles.Reset();
 	}
 
 	Files.Reset();
 	Files.Append(SourceFiles);
 	Files.Append(ConfigFiles);
+	Files.Append(ContentFiles);
+	Files.Append(ProjectFiles);
 }
 
 void UPjcSubsystem::GetAssetsDependencies(TSet<FAssetData>& Assets)
@@ -1566,6 +2197,17 @@ void UPjcSubsystem::TryOpenFile(const FString& InPath)
 	FPlatformProcess::LaunchFileInDefaultExternalApplication(*InPath);
 }
 
+void UPjcSubsystem::TryOpenFileAtLine(const FString& InPath, const int32 InLine)
+{
+	if (InPath.IsEmpty()) return;
+	if (!FPaths::FileExists(InPath)) return;
+
+	if (!FSourceCodeNavigation::OpenSourceFile(InPath, InLine))
+	{
+		TryOpenFile(InPath);
+	}
+}
+
 
 FAssetRegistryModule& UPjcSubsystem::GetModuleAssetRegistry()
 {
@@ -1587,101 +2229,521 @@ FPropertyEditorModule& UPjcSubsystem::GetModulePropertyEditor()
 	return FModuleManager::LoadModuleChecked<FPropertyEditorModule>(PjcConstants::ModulePropertyEditor);
 }
 
-void UPjcSubsystem::BucketFill(TArray<FAssetData>& AssetsUnused, TArray<FAssetData>& Bucket, const int32 BucketSize)
+bool UPjcSubsystem::BucketPrepare(const TArrayView<const FAssetData>& Bucket, TArray<UObject*>& LoadedAssets)
 {
-	// Searching Root assets (assets without referencers)
-	int32 Index = 0;
-	TArray<FName> Refs;
-	while (Bucket.Num() < BucketSize && AssetsUnused.IsValidIndex(Index))
+	TArray<FString> ObjectPaths;
+	ObjectPaths.Reserve(Bucket.Num());
+
+	for (const auto& Asset : Bucket)
 	{
-		const FAssetData CurrentAsset = AssetsUnused[Index];
-		GetModuleAssetRegistry().Get().GetReferencers(CurrentAsset.PackageName, Refs);
-		Refs.RemoveAllSwap([&](const FName& Ref)
+		ObjectPaths.Add(Asset.ObjectPath.ToString());
+	}
+
+	return AssetViewUtils::LoadAssetsIfNeeded(ObjectPaths, LoadedAssets, false, true);
+}
+
+int32 UPjcSubsystem::BucketDelete(const TArray<UObject*>& LoadedAssets)
+{
+	int32 DeletedAssetsNum = ObjectTools::DeleteObjects(LoadedAssets, false);
+
+	if (DeletedAssetsNum == 0)
+	{
+		DeletedAssetsNum = ObjectTools::ForceDeleteObjects(LoadedAssets, false);
+	}
+
+	return DeletedAssetsNum;
+}
+
+int32 UPjcSubsystem::FilesDelete(const TArray<FString>& InFiles, const FString& InTitle, const bool bShowSlowTask)
+{
+	FScopedSlowTask SlowTask(
+		InFiles.Num(),
+		FText::FromString(InTitle),
+		bShowSlowTask && GIsEditor && !IsRunningCommandlet()
+	);
+	SlowTask.MakeDialog(false, false);
+
+	// deleting is bound by file system, so only few workers are used and progress is reported once per batch
+	const int32 NumWorkers = FMath::Clamp(FTaskGraphInterface::Get().GetNumWorkerThreads() + 1, 1, PjcConstants::DeleteWorkersMax);
+
+	TArray<bool> FilesDeleted;
+	FilesDeleted.Init(false, InFiles.Num());
+
+	FThreadSafeCounter NumFilesDeleted;
+
+	for (int32 BatchStart = 0; BatchStart < InFiles.Num(); BatchStart += PjcConstants::DeleteBatchSize)
+	{
+		const int32 BatchEnd = FMath::Min(BatchStart + PjcConstants::DeleteBatchSize, InFiles.Num());
+
+		FThreadSafeCounter NextIndex{BatchStart};
+		ParallelFor(FMath::Min(NumWorkers, BatchEnd - BatchStart), [&](int32)
 		{
-			return !Ref.ToString().StartsWith(PjcConstants::PathRoot.ToString()) || Ref.IsEqual(CurrentAsset.PackageName);
-		}, false);
-		Refs.Shrink();
+			for (int32 Index = NextIndex.Increment() - 1; Index < BatchEnd; Index = NextIndex.Increment() - 1)
+			{
+				if (!IFileManager::Get().Delete(*InFiles[Index], true)) continue;
 
-		if (Refs.Num() == 0)
+				FilesDeleted[Index] = true;
+				NumFilesDeleted.Increment();
+			}
+		});
+
+		for (int32 Index = BatchStart; Index < BatchEnd; ++Index)
 		{
-			Bucket.AddUnique(CurrentAsset);
-			AssetsUnused.RemoveAt(Index);
+			if (FilesDeleted[Index]) continue;
+
+			UE_LOG(LogProjectCleaner, Error, TEXT("Failed to delete file: %s"), *InFiles[Index]);
 		}
 
-		Refs.Reset();
+		const FString ProgressMsg = FString::Printf(TEXT("Deleted %d of %d files"), NumFilesDeleted.GetValue(), InFiles.Num());
+		SlowTask.EnterProgressFrame(BatchEnd - BatchStart, FText::FromString(ProgressMsg));
+	}
+
+	// views are refreshed once for whole deletion, not per file
+	FPjcContentIndex::MarkDirty();
+	FPjcContentIndex::OnContentChanged().Broadcast();
+
+	return NumFilesDeleted.GetValue();
+}
+
+void UPjcSubsystem::BucketSplit(const TArrayView<const FAssetData>& Bucket, const TSet<FName>& PackagesDeletedLoadFree, TArray<FAssetData>& AssetsLoadFree, TArray<FAssetData>& AssetsLoad)
+{
+	TMap<FName, TArray<FName>> Candidates;
+
+	for (const auto& Asset : Bucket)
+	{
+		if (Candidates.Contains(Asset.PackageName)) continue;
+
+		// package in memory can be referenced by other objects, only ObjectTools can safely clean those up
+		if (FindPackage(nullptr, *Asset.PackageName.ToString())) continue;
+		if (!FPackageName::DoesPackageExist(Asset.PackageName.ToString())) continue;
+
+		TArray<FName> Refs;
+		GetModuleAssetRegistry().Get().GetReferencers(Asset.PackageName, Refs);
+		Refs.RemoveAllSwap([&](const FName& Ref)
+		{
+			return Ref == Asset.PackageName || PackagesDeletedLoadFree.Contains(Ref);
+		});
 
-		++Index;
+		Candidates.Add(Asset.PackageName, MoveTemp(Refs));
 	}
 
-	if (Bucket.Num() > 0)
+	// package can skip loading only if every referencer is deleted without loading too,
+	// otherwise referencer would be loaded later with missing import
+	bool bChanged = true;
+	while (bChanged)
 	{
-		return;
+		bChanged = false;
+
+		for (auto It = Candidates.CreateIterator(); It; ++It)
+		{
+			const bool bRefsLoad = It.Value().ContainsByPredicate([&](const FName& Ref)
+			{
+				return !Candidates.Contains(Ref);
+			});
+
+			if (!bRefsLoad) continue;
+
+			It.RemoveCurrent();
+			bChanged = true;
+		}
 	}
 
-	// if root assets not found, we deleting assets single by finding its referencers
-	if (AssetsUnused.Num() == 0)
+	for (const auto& Asset : Bucket)
 	{
-		return;
+		if (Candidates.Contains(Asset.PackageName))
+		{
+			AssetsLoadFree.Add(Asset);
+		}
+		else
+		{
+			AssetsLoad.Add(Asset);
+		}
+	}
+}
+
+bool UPjcSubsystem::PackageGetFiles(const FName& InPackageName, TArray<FString>& OutFiles)
+{
+	FString PackageFile;
+	if (!FPackageName::DoesPackageExist(InPackageName.ToString(), nullptr, &PackageFile)) return false;
+
+	// package file always goes first, sidecar files follow it
+	const int32 PackageFileIndex = OutFiles.Emplace(FPaths::ConvertRelativePathToFull(PackageFile));
+
+	for (const auto& Ext : PjcConstants::SidecarFileExtensions)
+	{
+		FString SidecarFile = FPaths::ChangeExtension(OutFiles[PackageFileIndex], Ext);
+		if (!IFileManager::Get().FileExists(*SidecarFile)) continue;
+
+		OutFiles.Emplace(MoveTemp(SidecarFile));
 	}
 
-	TArray<FAssetData> Stack;
-	Stack.Add(AssetsUnused[0]);
+	return true;
+}
 
-	while (Stack.Num() > 0)
+int32 UPjcSubsystem::BucketDeleteLoadFree(const TArray<FAssetData>& Assets, TSet<FName>& PackagesDeletedLoadFree)
+{
+	TMap<FName, FString> PackageFiles;
+	TArray<FString> Files;
+
+	for (const auto& Asset : Assets)
 	{
-		const FAssetData Current = Stack.Pop(false);
-		Bucket.AddUnique(Current);
-		AssetsUnused.Remove(Current);
+		if (PackageFiles.Contains(Asset.PackageName)) continue;
 
-		GetModuleAssetRegistry().Get().GetReferencers(Current.PackageName, Refs);
+		const int32 NumFiles = Files.Num();
+		if (!PackageGetFiles(Asset.PackageName, Files)) continue;
 
-		Refs.RemoveAllSwap([&](const FName& Ref)
-		{
-			return !Ref.ToString().StartsWith(PjcConstants::PathRoot.ToString()) || Ref.IsEqual(Current.PackageName);
-		}, false);
-		Refs.Shrink();
+		PackageFiles.Add(Asset.PackageName, Files[NumFiles]);
+	}
 
-		for (const auto& Ref : Refs)
+	TArray<FString> FilesLocal;
+	ISourceControlModule& SourceControlModule = ISourceControlModule::Get();
+
+	if (SourceControlModule.IsEnabled() && SourceControlModule.GetProvider().IsAvailable())
+	{
+		ISourceControlProvider& Provider = SourceControlModule.GetProvider();
+
+		TArray<FSourceControlStateRef> States;
+		Provider.GetState(Files, States, EStateCacheUsage::ForceUpdate);
+
+		TArray<FString> FilesDelete;
+		TArray<FString> FilesRevert;
+
+		for (const auto& State : States)
 		{
-			const FString ObjectPath = Ref.ToString() + TEXT(".") + FPaths::GetBaseFilename(*Ref.ToString());
-			const FAssetData AssetData = GetModuleAssetRegistry().Get().GetAssetByObjectPath(FName{*ObjectPath});
-			if (AssetData.IsValid())
+			if (State->IsAdded())
 			{
-				if (!Bucket.Contains(AssetData))
-				{
-					Stack.Add(AssetData);
-				}
-
-				Bucket.AddUnique(AssetData);
-				AssetsUnused.Remove(AssetData);
+				FilesRevert.Add(State->GetFilename());
+				FilesLocal.Add(State->GetFilename());
+			}
+			else if (State->IsCheckedOut())
+			{
+				// source control refuses to delete checked out files, local edits are reverted first, same as ObjectTools::CleanupAfterSuccessfulDelete
+				FilesRevert.Add(State->GetFilename());
+				FilesDelete.Add(State->GetFilename());
+			}
+			else if (State->IsSourceControlled() && !State->IsDeleted())
+			{
+				FilesDelete.Add(State->GetFilename());
+			}
+			else
+			{
+				FilesLocal.Add(State->GetFilename());
 			}
 		}
 
-		Refs.Reset();
+		// whole bucket is sent to source control in single batch
+		if (FilesRevert.Num() > 0 && Provider.Execute(ISourceControlOperation::Create<FRevert>(), FilesRevert) != ECommandResult::Succeeded)
+		{
+			UE_LOG(LogProjectCleaner, Error, TEXT("Failed to revert %d added or checked out files in source control"), FilesRevert.Num());
+		}
+
+		if (FilesDelete.Num() > 0 && Provider.Execute(ISourceControlOperation::Create<FDelete>(), FilesDelete) != ECommandResult::Succeeded)
+		{
+			UE_LOG(LogProjectCleaner, Error, TEXT("Failed to mark %d files for delete in source control"), FilesDelete.Num());
+		}
+	}
+	else
+	{
+		FilesLocal = MoveTemp(Files);
+	}
+
+	for (const auto& File : FilesLocal)
+	{
+		if (!IFileManager::Get().FileExists(*File)) continue;
+		if (IFileManager::Get().Delete(*File, false, true)) continue;
+
+		UE_LOG(LogProjectCleaner, Error, TEXT("Failed to delete file: %s"), *File);
+	}
+
+	// package counts as deleted only if its file is gone, sidecars left behind are reported as external files
+	int32 NumAssetsDeleted = 0;
+	TSet<FString> PackageFilesDeleted;
+	for (const auto& Asset : Assets)
+	{
+		const FString* PackageFile = PackageFiles.Find(Asset.PackageName);
+		if (!PackageFile || IFileManager::Get().FileExists(**PackageFile)) continue;
+
+		PackagesDeletedLoadFree.Add(Asset.PackageName);
+		PackageFilesDeleted.Add(*PackageFile);
+		++NumAssetsDeleted;
+	}
+
+	// packages were never loaded, so nothing tells AssetRegistry they are gone. rescan of missing files removes their assets right away,
+	// so referencers and unused assets of next buckets are computed without them
+	if (PackageFilesDeleted.Num() > 0)
+	{
+		GetModuleAssetRegistry().Get().ScanModifiedAssetFiles(PackageFilesDeleted.Array());
 	}
+
+	return NumAssetsDeleted;
 }
 
-bool UPjcSubsystem::BucketPrepare(const TArray<FAssetData>& Bucket, TArray<UObject*>& LoadedAssets)
+const FPjcIndirectIndex& UPjcSubsystem::GetIndirectIndex()
 {
-	TArray<FString> ObjectPaths;
-	ObjectPaths.Reserve(Bucket.Num());
+	check(IsInGameThread());
 
-	for (const auto& Asset : Bucket)
+	if (!PjcSubsystemLocal::bIndirectIndexLoaded)
 	{
-		ObjectPaths.Add(Asset.ObjectPath.ToString());
+		PjcSubsystemLocal::IndirectIndex.Load();
+		PjcSubsystemLocal::bIndirectIndexLoaded = true;
 	}
 
-	return AssetViewUtils::LoadAssetsIfNeeded(ObjectPaths, LoadedAssets, false, true);
+	return PjcSubsystemLocal::IndirectIndex;
 }
 
-int32 UPjcSubsystem::BucketDelete(const TArray<UObject*>& LoadedAssets)
+FString UPjcSubsystem::GetDeletionPlanFilePath()
 {
-	int32 DeletedAssetsNum = ObjectTools::DeleteObjects(LoadedAssets, false);
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / PjcConstants::PathSavedDirName / PjcConstants::FileDeletionPlanName);
+}
 
-	if (DeletedAssetsNum == 0)
+uint64 UPjcSubsystem::GetDeletionMemoryBudget()
+{
+	const int32 MemoryBudgetMb = GetDefault<UPjcSubsystem>()->DeleteMemoryBudgetMb;
+	if (MemoryBudgetMb > 0) return static_cast<uint64>(MemoryBudgetMb) * 1024 * 1024;
+
+	return static_cast<uint64>(FPlatformMemory::GetStats().TotalPhysical * PjcConstants::DeleteMemoryBudgetRatio);
+}
+
+int32 UPjcSubsystem::GetDeletionBucketSizeNext(const int32 InBucketSize, const int32 InNumAssetsLoaded, const uint64 InMemoryGrowth, const uint64 InMemoryUsed, const uint64 InMemoryBudget)
+{
+	// still over budget even after garbage collection, so next bucket must load less
+	if (InMemoryUsed >= InMemoryBudget)
 	{
-		DeletedAssetsNum = ObjectTools::ForceDeleteObjects(LoadedAssets, false);
+		return FMath::Max(PjcConstants::BucketSizeMin, InBucketSize / 2);
 	}
 
-	return DeletedAssetsNum;
+	const int32 BucketSizeGrow = FMath::Min(PjcConstants::BucketSizeMax, InBucketSize * 2);
+
+	// nothing was loaded, so memory cost of assets is unknown yet
+	if (InNumAssetsLoaded == 0 || InMemoryGrowth == 0) return BucketSizeGrow;
+
+	// next bucket is sized to fit remaining headroom, assuming its assets cost about same as previous ones
+	const uint64 MemoryPerAsset = FMath::Max<uint64>(1, InMemoryGrowth / InNumAssetsLoaded);
+	const uint64 BucketSizeFit = (InMemoryBudget - InMemoryUsed) / MemoryPerAsset;
+
+	return FMath::Clamp(static_cast<int32>(FMath::Min<uint64>(BucketSizeFit, MAX_int32)), PjcConstants::BucketSizeMin, BucketSizeGrow);
+}
+
+bool UPjcSubsystem::DeletionPrepare()
+{
+	if (!DeletionCanStart()) return false;
+
+	TArray<FAssetData> Redirectors;
+	GetProjectRedirectors(Redirectors);
+	FixProjectRedirectors(Redirectors);
+
+	if (ProjectHasRedirectors())
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Failed to delete unused assets because project contains redirectors that failed to fix."));
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Please fix redirectors first manually and then try again."));
+		return false;
+	}
+
+	if (!FEditorFileUtils::SaveDirtyPackages(true, true, true, false, false, false))
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Failed to delete unused assets because project contains unsaved assets."));
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Please save those assets and then try again. Check OutputLog for more information"));
+		return false;
+	}
+
+	return true;
+}
+
+bool UPjcSubsystem::DeletionCanStart()
+{
+	if (GetModuleAssetRegistry().Get().IsLoadingAssets())
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Failed to delete unused assets, because AssetRegistry still discovering assets."));
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Please wait until it finished adn then try again."));
+		return false;
+	}
+
+	if (GEditor && !GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->CloseAllAssetEditors())
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Failed to delete unused assets because some editor windows are still open."));
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Please try again, check the OutputLog for reasons why certain windows haven't closed, or try to manually close all editor windows."));
+		return false;
+	}
+
+	return true;
+}
+
+void UPjcSubsystem::DeletionExecute(const FPjcDeletionPlan& InDeletionPlan, const bool bShowSlowTask, const bool bShowEditorNotification)
+{
+	const int32 NumAssetsTotal = InDeletionPlan.GetNumAssets();
+	int32 NumAssetsDeleted = 0;
+
+	TArray<UObject*> LoadedAssets;
+	LoadedAssets.Reserve(PjcConstants::BucketSize);
+
+	// Assets must be loaded first when deleting, which can cause a lot of unnecessary shader compilation work.
+	// Therefore, we disable shader compilation during this stage for faster deletion and then enable it afterwards.
+	ShaderCompilationDisable();
+
+	FScopedSlowTask SlowTask(
+		NumAssetsTotal,
+		FText::FromString(TEXT("Deleting unused assets...")),
+		bShowSlowTask && GIsEditor && !IsRunningCommandlet()
+	);
+	SlowTask.MakeDialog(false, false);
+
+	bool bErrors = false;
+
+	const bool bLoadFree = GetDefault<UPjcSubsystem>()->bDeleteAssetsLoadFree;
+	TSet<FName> PackagesDeletedLoadFree;
+	TArray<FAssetData> AssetsLoadFree;
+	TArray<FAssetData> AssetsLoad;
+
+	// bucket size follows memory used by loaded assets, so large cleanups stay under budget
+	const uint64 MemoryBudget = GetDeletionMemoryBudget();
+	const uint64 MemoryWatermark = static_cast<uint64>(MemoryBudget * PjcConstants::DeleteMemoryWatermark);
+	uint64 MemoryPeak = 0;
+	int32 BucketSize = PjcConstants::BucketSize;
+	int32 NumBuckets = 0;
+	int32 NumGarbageCollections = 0;
+
+	FPjcDeletionJournal Journal;
+	Journal.Begin(InDeletionPlan);
+
+	for (int32 Start = 0; Start < NumAssetsTotal;)
+	{
+		const int32 End = InDeletionPlan.GetSliceEnd(Start, BucketSize);
+		const TArrayView<const FAssetData> Bucket = InDeletionPlan.GetSlice(Start, End);
+		Start = End;
+		++NumBuckets;
+
+		const uint64 MemoryBefore = FPlatformMemory::GetStats().UsedPhysical;
+		uint64 MemoryLoaded = MemoryBefore;
+
+		AssetsLoadFree.Reset();
+		AssetsLoad.Reset();
+
+		if (bLoadFree)
+		{
+			BucketSplit(Bucket, PackagesDeletedLoadFree, AssetsLoadFree, AssetsLoad);
+		}
+		else
+		{
+			AssetsLoad.Append(Bucket.GetData(), Bucket.Num());
+		}
+
+		int32 NumAssetsDeletedBucket = 0;
+
+		if (AssetsLoadFree.Num() > 0)
+		{
+			NumAssetsDeletedBucket += BucketDeleteLoadFree(AssetsLoadFree, PackagesDeletedLoadFree);
+		}
+
+		if (AssetsLoad.Num() > 0)
+		{
+			if (!BucketPrepare(AssetsLoad, LoadedAssets))
+			{
+				bErrors = true;
+				NumAssetsDeleted += NumAssetsDeletedBucket;
+				UE_LOG(LogProjectCleaner, Error, TEXT("Failed to load some assets. Aborting."));
+				break;
+			}
+
+			// memory is highest right after loading, deletion itself may already collect garbage
+			MemoryLoaded = FPlatformMemory::GetStats().UsedPhysical;
+			NumAssetsDeletedBucket += BucketDelete(LoadedAssets);
+		}
+
+		NumAssetsDeleted += NumAssetsDeletedBucket;
+
+		const FString ProgressMsg = FString::Printf(TEXT("Deleted %d of %d assets"), NumAssetsDeleted, NumAssetsTotal);
+		SlowTask.EnterProgressFrame(Bucket.Num(), FText::FromString(ProgressMsg));
+
+		LoadedAssets.Reset();
+
+		// slice is committed only when all its assets are confirmed deleted, otherwise resume retries whole slice.
+		// later slices are not deleted either, as journal commits only finished prefix of plan
+		if (NumAssetsDeletedBucket != Bucket.Num())
+		{
+			bErrors = true;
+			UE_LOG(LogProjectCleaner, Error, TEXT("Deleted only %d of %d assets in bucket. Aborting."), NumAssetsDeletedBucket, Bucket.Num());
+			break;
+		}
+
+		Journal.Commit(End);
+
+		// dependencies loaded together with deleted assets stay in memory until next garbage collection
+		uint64 MemoryUsed = FPlatformMemory::GetStats().UsedPhysical;
+		MemoryPeak = FMath::Max(MemoryPeak, FMath::Max(MemoryLoaded, MemoryUsed));
+
+		if (MemoryUsed > MemoryWatermark)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			MemoryUsed = FPlatformMemory::GetStats().UsedPhysical;
+			++NumGarbageCollections;
+		}
+
+		const uint64 MemoryGrowth = MemoryLoaded > MemoryBefore ? MemoryLoaded - MemoryBefore : 0;
+		BucketSize = GetDeletionBucketSizeNext(BucketSize, AssetsLoad.Num(), MemoryGrowth, MemoryUsed, MemoryBudget);
+	}
+
+	// aborted deletion keeps its journal, so it can be resumed after problem is fixed
+	if (bErrors)
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Deletion can be resumed from last finished bucket."));
+	}
+	else
+	{
+		Journal.Finish();
+	}
+
+	UE_LOG(
+		LogProjectCleaner,
+		Display,
+		TEXT("Deleted in %d buckets with %d garbage collections, peak memory %s of %s budget"),
+		NumBuckets,
+		NumGarbageCollections,
+		*FText::AsMemory(MemoryPeak, IEC).ToString(),
+		*FText::AsMemory(MemoryBudget, IEC).ToString()
+	);
+
+	const TSet<FName> EmptyPackages = GetModuleAssetRegistry().Get().GetCachedEmptyPackages();
+	TArray<UPackage*> AssetPackages;
+	for (const auto& EmptyPackage : EmptyPackages)
+	{
+		UPackage* Package = FindPackage(nullptr, *EmptyPackage.ToString());
+		if (Package && Package->IsValidLowLevel())
+		{
+			AssetPackages.Add(Package);
+		}
+	}
+
+	if (AssetPackages.Num() > 0)
+	{
+		ObjectTools::CleanupAfterSuccessfulDelete(AssetPackages);
+	}
+
+	ShaderCompilationEnable();
+
+	FPjcContentIndex::MarkDirty();
+
+	if (PackagesDeletedLoadFree.Num() > 0)
+	{
+		UE_LOG(LogProjectCleaner, Display, TEXT("Deleted %d packages without loading them"), PackagesDeletedLoadFree.Num());
+	}
+
+	const FString Msg = FString::Printf(TEXT("Deleted %d of %d assets"), NumAssetsDeleted, NumAssetsTotal);
+	UE_LOG(LogProjectCleaner, Display, TEXT("%s"), *Msg);
+
+	if (bErrors)
+	{
+		UE_LOG(LogProjectCleaner, Error, TEXT("There very some errors while deleting assets. Please check OutputLog for more information."));
+	}
+
+	if (bShowEditorNotification && GEditor)
+	{
+		if (NumAssetsDeleted == NumAssetsTotal)
+		{
+			ShowNotification(Msg, SNotificationItem::CS_Success, 3.0f);
+		}
+		else
+		{
+			ShowNotificationWithOutputLog(Msg, SNotificationItem::CS_Fail, 5.0f);
+		}
+	}
 }
@@ -123,6 +123,28 @@ TSharedRef<SWidget> SPjcItemTree::GenerateWidgetForColumn(const FName& InColumnN
 			];
 	}
 
+	if (InColumnName.IsEqual(TEXT("DiskSize")))
+	{
+		const FString ToolTip = FString::Printf(
+			TEXT("Used: %s\nUnused: %s\nSidecar: %s\nExternal: %s"),
+			*FText::AsMemory(Item->DiskUsage.SizeUsed, IEC).ToString(),
+			*FText::AsMemory(Item->DiskUsage.SizeUnused, IEC).ToString(),
+			*FText::AsMemory(Item->DiskUsage.SizeSidecar, IEC).ToString(),
+			*FText::AsMemory(Item->DiskUsage.SizeExternal, IEC).ToString()
+		);
+
+		return
+			SNew(SHorizontalBox).ToolTipText(FText::FromString(ToolTip))
+			+ SHorizontalBox::Slot().Padding(FMargin{5.0f, 1.0f}).FillWidth(1.0f)
+			[
+				SNew(STextBlock)
+				.AutoWrapText(false)
+				.Justification(ETextJustify::Center)
+				.ColorAndOpacity(FLinearColor::White)
+				.Text(FText::AsMemory(Item->DiskUsage.GetSizeTotal(), IEC))
+			];
+	}
+
 	return SNew(STextBlock).Text(FText::FromString(TEXT("")));
 }
 
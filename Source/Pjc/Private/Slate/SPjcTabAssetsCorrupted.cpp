@@ -5,6 +5,7 @@
 #include "PjcCmds.h"
 #include "PjcStyles.h"
 #include "PjcConstants.h"
+#include "PjcContentIndex.h"
 #include "PjcSubsystem.h"
 // Engine Headers
 #include "Widgets/Input/SSearchBox.h"
@@ -16,6 +17,8 @@ void SPjcTabAssetsCorrupted::Construct(const FArguments& InArgs)
 {
 	Cmds = MakeShareable(new FUICommandList);
 
+	DelegateHandleContentChanged = FPjcContentIndex::OnContentChanged().AddRaw(this, &SPjcTabAssetsCorrupted::OnContentChanged);
+
 	Cmds->MapAction(
 		FPjcCmds::Get().Refresh,
 		FExecuteAction::CreateRaw(this, &SPjcTabAssetsCorrupted::OnRefresh)
@@ -38,7 +41,14 @@ void SPjcTabAssetsCorrupted::Construct(const FArguments& InArgs)
 	.OnGenerateRow(this, &SPjcTabAssetsCorrupted::OnListGenerateRow)
 	.OnContextMenuOpening_Raw(this, &SPjcTabAssetsCorrupted::OnContextMenuOpening)
 	.SelectionMode(ESelectionMode::Multi)
-	.HeaderRow(GetListHeaderRow());
+	.HeaderRow(GetListHeaderRow(true));
+
+	// suspect files are registered assets, so they are listed for review only and can not be selected for deletion
+	SAssignNew(ListViewSuspect, SListView<TSharedPtr<FPjcCorruptedAssetItem>>)
+	.ListItemsSource(&ItemsSuspectFiltered)
+	.OnGenerateRow(this, &SPjcTabAssetsCorrupted::OnListGenerateRow)
+	.SelectionMode(ESelectionMode::None)
+	.HeaderRow(GetListHeaderRow(false));
 
 	ChildSlot
 	[
@@ -133,6 +143,30 @@ void SPjcTabAssetsCorrupted::Construct(const FArguments& InArgs)
 			]
 		]
 		+ SVerticalBox::Slot().AutoHeight().Padding(5.0f)
+		[
+			SNew(STextBlock)
+			.Visibility_Raw(this, &SPjcTabAssetsCorrupted::GetSuspectVisibility)
+			.Justification(ETextJustify::Center)
+			.ColorAndOpacity(FPjcStyles::Get().GetColor("ProjectCleaner.Color.Gray"))
+			.ShadowOffset(FVector2D{0.5f, 0.5f})
+			.ShadowColorAndOpacity(FLinearColor::Black)
+			.Font(FPjcStyles::GetFont("Bold", 10))
+			.AutoWrapText(true)
+			.Text(FText::FromString(TEXT("Suspect asset files. These are registered by AssetRegistry, but their package header or size looks broken. Check the OutputLog for reasons and open or resave them manually, they are not deleted from here.")))
+		]
+		+ SVerticalBox::Slot().FillHeight(0.5f).Padding(5.0f)
+		[
+			SNew(SScrollBox)
+			.Visibility_Raw(this, &SPjcTabAssetsCorrupted::GetSuspectVisibility)
+			.ScrollWhenFocusChanges(EScrollWhenFocusChanges::NoScroll)
+			.AnimateWheelScrolling(true)
+			.AllowOverscroll(EAllowOverscroll::No)
+			+ SScrollBox::Slot().Padding(5.0f)
+			[
+				ListViewSuspect.ToSharedRef()
+			]
+		]
+		+ SVerticalBox::Slot().AutoHeight().Padding(5.0f)
 		[
 			SNew(SHorizontalBox)
 			+ SHorizontalBox::Slot().FillWidth(1.0f).HAlign(HAlign_Left).VAlign(VAlign_Center).Padding(3.0f, 0.0f, 0.0f, 0.0f)
@@ -143,10 +177,15 @@ void SPjcTabAssetsCorrupted::Construct(const FArguments& InArgs)
 	];
 }
 
-void SPjcTabAssetsCorrupted::ListUpdateData()
+SPjcTabAssetsCorrupted::~SPjcTabAssetsCorrupted()
+{
+	FPjcContentIndex::OnContentChanged().Remove(DelegateHandleContentChanged);
+}
+
+void SPjcTabAssetsCorrupted::ListUpdateData(const bool bShowSlowTask)
 {
 	TArray<FString> FilesCorrupted;
-	UPjcSubsystem::GetFilesCorrupted(FilesCorrupted, true);
+	UPjcSubsystem::GetFilesCorrupted(FilesCorrupted, bShowSlowTask);
 
 	ItemsAll.Reset(FilesCorrupted.Num());
 
@@ -155,7 +194,7 @@ void SPjcTabAssetsCorrupted::ListUpdateData()
 
 	for (const auto& File : FilesCorrupted)
 	{
-		const int64 FileSize = IFileManager::Get().FileSize(*File);
+		const int64 FileSize = UPjcSubsystem::GetFileSize(File);
 		const FString FileName = FPaths::GetBaseFilename(File);
 		const FString FileExt = FPaths::GetExtension(File, false).ToLower();
 		SizeFilesTotal += FileSize;
@@ -171,6 +210,25 @@ void SPjcTabAssetsCorrupted::ListUpdateData()
 			)
 		);
 	}
+
+	TArray<FString> FilesSuspect;
+	UPjcSubsystem::GetFilesSuspect(FilesSuspect, bShowSlowTask);
+
+	ItemsSuspectAll.Reset(FilesSuspect.Num());
+
+	for (const auto& File : FilesSuspect)
+	{
+		ItemsSuspectAll.Emplace(
+			MakeShareable(
+				new FPjcCorruptedAssetItem{
+					UPjcSubsystem::GetFileSize(File),
+					FPaths::GetBaseFilename(File),
+					FPaths::GetExtension(File, false).ToLower(),
+					File
+				}
+			)
+		);
+	}
 }
 
 void SPjcTabAssetsCorrupted::ListUpdateView()
@@ -211,6 +269,27 @@ void SPjcTabAssetsCorrupted::ListUpdateView()
 	ListView->ClearSelection();
 	ListView->ClearHighlightedItems();
 	ListView->RebuildList();
+
+	ItemsSuspectFiltered.Reset();
+	ItemsSuspectFiltered.Reserve(ItemsSuspectAll.Num());
+
+	for (const auto& Item : ItemsSuspectAll)
+	{
+		if (!Item.IsValid()) continue;
+		if (!SearchText.IsEmpty() && !Item->FilePath.Contains(SearchString) && !Item->FileName.Contains(SearchString)) continue;
+
+		ItemsSuspectFiltered.Emplace(Item);
+	}
+
+	ItemsSuspectFiltered.Sort([](const TSharedPtr<FPjcCorruptedAssetItem>& Item1, const TSharedPtr<FPjcCorruptedAssetItem>& Item2)
+	{
+		return Item1->FilePath < Item2->FilePath;
+	});
+
+	if (ListViewSuspect.IsValid())
+	{
+		ListViewSuspect->RebuildList();
+	}
 }
 
 void SPjcTabAssetsCorrupted::OnListSort(EColumnSortPriority::Type SortPriority, const FName& ColumnName, EColumnSortMode::Type InSortMode)
@@ -271,9 +350,10 @@ void SPjcTabAssetsCorrupted::OnSearchTextCommitted(const FText& InSearchText, ET
 	ListUpdateView();
 }
 
-TSharedRef<SHeaderRow> SPjcTabAssetsCorrupted::GetListHeaderRow()
+TSharedRef<SHeaderRow> SPjcTabAssetsCorrupted::GetListHeaderRow(const bool bSortable)
 {
 	const FMargin HeaderMargin{5.0f};
+	const FOnSortModeChanged OnSort = bSortable ? FOnSortModeChanged::CreateRaw(this, &SPjcTabAssetsCorrupted::OnListSort) : FOnSortModeChanged{};
 
 	return
 		SNew(SHeaderRow)
@@ -283,7 +363,7 @@ TSharedRef<SHeaderRow> SPjcTabAssetsCorrupted::GetListHeaderRow()
 		.VAlignCell(VAlign_Center)
 		.HAlignHeader(HAlign_Center)
 		.HeaderContentPadding(HeaderMargin)
-		.OnSort_Raw(this, &SPjcTabAssetsCorrupted::OnListSort)
+		.OnSort(OnSort)
 		[
 			SNew(STextBlock)
 			.Text(FText::FromString(TEXT("FilePath")))
@@ -296,7 +376,7 @@ TSharedRef<SHeaderRow> SPjcTabAssetsCorrupted::GetListHeaderRow()
 		.VAlignCell(VAlign_Center)
 		.HAlignHeader(HAlign_Center)
 		.HeaderContentPadding(HeaderMargin)
-		.OnSort_Raw(this, &SPjcTabAssetsCorrupted::OnListSort)
+		.OnSort(OnSort)
 		[
 			SNew(STextBlock)
 			.Text(FText::FromString(TEXT("FileName")))
@@ -309,7 +389,7 @@ TSharedRef<SHeaderRow> SPjcTabAssetsCorrupted::GetListHeaderRow()
 		.VAlignCell(VAlign_Center)
 		.HAlignHeader(HAlign_Center)
 		.HeaderContentPadding(HeaderMargin)
-		.OnSort_Raw(this, &SPjcTabAssetsCorrupted::OnListSort)
+		.OnSort(OnSort)
 		[
 			SNew(STextBlock)
 			.Text(FText::FromString(TEXT("FileExtension")))
@@ -322,7 +402,7 @@ TSharedRef<SHeaderRow> SPjcTabAssetsCorrupted::GetListHeaderRow()
 		.VAlignCell(VAlign_Center)
 		.HAlignHeader(HAlign_Center)
 		.HeaderContentPadding(HeaderMargin)
-		.OnSort_Raw(this, &SPjcTabAssetsCorrupted::OnListSort)
+		.OnSort(OnSort)
 		[
 			SNew(STextBlock)
 			.Text(FText::FromString(TEXT("FileSize")))
@@ -369,10 +449,10 @@ FText SPjcTabAssetsCorrupted::GetTxtSummary() const
 	{
 		const int32 NumFilesSelected = ListView->GetSelectedItems().Num();
 
-		return FText::FromString(FString::Printf(TEXT("Total - %d (%s). Selected %d"), NumFilesTotal, *FText::AsMemory(SizeFilesTotal, IEC).ToString(), NumFilesSelected));
+		return FText::FromString(FString::Printf(TEXT("Total - %d (%s). Selected %d. Suspect - %d"), NumFilesTotal, *FText::AsMemory(SizeFilesTotal, IEC).ToString(), NumFilesSelected, ItemsSuspectAll.Num()));
 	}
 
-	return FText::FromString(FString::Printf(TEXT("Total - %d (%s)"), NumFilesTotal, *FText::AsMemory(SizeFilesTotal, IEC).ToString()));
+	return FText::FromString(FString::Printf(TEXT("Total - %d (%s). Suspect - %d"), NumFilesTotal, *FText::AsMemory(SizeFilesTotal, IEC).ToString(), ItemsSuspectAll.Num()));
 }
 
 int32 SPjcTabAssetsCorrupted::GetWidgetIndex() const
@@ -380,9 +460,21 @@ int32 SPjcTabAssetsCorrupted::GetWidgetIndex() const
 	return ItemsAll.Num() == 0 ? PjcConstants::WidgetIndexIdle : PjcConstants::WidgetIndexWorking;
 }
 
+EVisibility SPjcTabAssetsCorrupted::GetSuspectVisibility() const
+{
+	return ItemsSuspectAll.Num() == 0 ? EVisibility::Collapsed : EVisibility::Visible;
+}
+
 void SPjcTabAssetsCorrupted::OnRefresh()
 {
-	ListUpdateData();
+	ListUpdateData(true);
+	ListUpdateView();
+}
+
+void SPjcTabAssetsCorrupted::OnContentChanged()
+{
+	// updated on every change reported by directory watcher, so without progress dialog
+	ListUpdateData(false);
 	ListUpdateView();
 }
 
@@ -396,16 +488,19 @@ void SPjcTabAssetsCorrupted::OnDelete()
 
 	const auto ItemsSelected = ListView->GetSelectedItems();
 	const int32 NumTotal = ItemsSelected.Num();
-	int32 NumDeleted = 0;
+
+	TArray<FString> Files;
+	Files.Reserve(NumTotal);
 
 	for (const auto& Item : ItemsSelected)
 	{
 		if (!Item.IsValid()) continue;
-		if (!IFileManager::Get().Delete(*Item->FilePath)) continue;
 
-		++NumDeleted;
+		Files.Add(Item->FilePath);
 	}
 
+	const int32 NumDeleted = UPjcSubsystem::FilesDelete(Files, TEXT("Deleting corrupted asset files ..."), true);
+
 	const FString Msg = FString::Printf(TEXT("Deleted %d of %d files"), NumDeleted, NumTotal);
 
 	if (NumDeleted == NumTotal)
@@ -417,7 +512,7 @@ void SPjcTabAssetsCorrupted::OnDelete()
 		UPjcSubsystem::ShowNotificationWithOutputLog(Msg, SNotificationItem::CS_Fail, 5.0f);
 	}
 
-	ListUpdateData();
+	ListUpdateData(true);
 	ListUpdateView();
 }
 
@@ -123,6 +123,9 @@ void SPjcTabAssetsIndirect::Construct(const FArguments& InArgs)
 			]
 		]
 	];
+
+	ListUpdateData(false);
+	ListUpdateView();
 }
 
 TSharedRef<SWidget> SPjcTabAssetsIndirect::CreateToolbar() const
@@ -218,12 +221,20 @@ void SPjcTabAssetsIndirect::OnMouseDoubleClicked(TSharedPtr<FPjcAssetIndirectInf
 	UPjcSubsystem::OpenAssetEditor(Item->Asset);
 }
 
-void SPjcTabAssetsIndirect::ListUpdateData()
+void SPjcTabAssetsIndirect::ListUpdateData(const bool bRescan)
 {
 	TArray<FAssetData> AssetsIndirect;
 	TArray<FPjcAssetIndirectInfo> AssetIndirectInfos;
 
-	UPjcSubsystem::GetAssetsIndirect(AssetsIndirect, AssetIndirectInfos, true);
+	// without rescan, results of last scan are loaded from index
+	if (bRescan)
+	{
+		UPjcSubsystem::GetAssetsIndirect(AssetsIndirect, AssetIndirectInfos, true);
+	}
+	else
+	{
+		UPjcSubsystem::GetAssetsIndirectFromIndex(AssetsIndirect, AssetIndirectInfos);
+	}
 
 	ItemsAll.Reset(AssetIndirectInfos.Num());
 
@@ -338,7 +349,7 @@ int32 SPjcTabAssetsIndirect::GetWidgetIndex() const
 
 void SPjcTabAssetsIndirect::OnRefresh()
 {
-	ListUpdateData();
+	ListUpdateData(true);
 	ListUpdateView();
 }
 
@@ -9,6 +9,7 @@
 #include "PjcStyles.h"
 #include "PjcSubsystem.h"
 #include "PjcConstants.h"
+#include "PjcContentIndex.h"
 #include "PjcFrontendFilters.h"
 // Engine Headers
 #include "FileHelpers.h"
@@ -35,6 +36,8 @@ void SPjcTabAssetsUnused::Construct(const FArguments& InArgs)
 	ContentBrowserSettings->SetDisplayPluginFolders(false);
 	ContentBrowserSettings->PostEditChange();
 
+	DelegateHandleContentChanged = FPjcContentIndex::OnContentChanged().AddRaw(this, &SPjcTabAssetsUnused::OnContentChanged);
+
 	Cmds = MakeShareable(new FUICommandList);
 	Cmds->MapAction(FPjcCmds::Get().ScanProject, FExecuteAction::CreateRaw(this, &SPjcTabAssetsUnused::OnProjectScan));
 	Cmds->MapAction(
@@ -42,6 +45,19 @@ void SPjcTabAssetsUnused::Construct(const FArguments& InArgs)
 		FExecuteAction::CreateRaw(this, &SPjcTabAssetsUnused::OnProjectClean),
 		FCanExecuteAction::CreateRaw(this, &SPjcTabAssetsUnused::CanCleanProject)
 	);
+	Cmds->MapAction(
+		FPjcCmds::Get().ResumeDeletion,
+		FExecuteAction::CreateRaw(this, &SPjcTabAssetsUnused::OnDeletionResume),
+		FCanExecuteAction::CreateRaw(this, &SPjcTabAssetsUnused::CanResumeDeletion)
+	);
+	Cmds->MapAction(
+		FPjcCmds::Get().QuarantineProject,
+		FExecuteAction::CreateRaw(this, &SPjcTabAssetsUnused::OnProjectQuarantine)
+	);
+	Cmds->MapAction(
+		FPjcCmds::Get().QuarantineRestore,
+		FExecuteAction::CreateRaw(this, &SPjcTabAssetsUnused::OnQuarantineRestore)
+	);
 	Cmds->MapAction(
 		FPjcCmds::Get().ClearExcludeSettings,
 		FExecuteAction::CreateRaw(this, &SPjcTabAssetsUnused::OnResetExcludeSettings)
@@ -195,6 +211,7 @@ void SPjcTabAssetsUnused::Construct(const FArguments& InArgs)
 	FilterEditor = MakeShareable(new FPjcFilterAssetsEditor(DefaultCategory));
 	FilterExcluded = MakeShareable(new FPjcFilterAssetsExcluded(DefaultCategory));
 	FilterExtReferenced = MakeShareable(new FPjcFilterAssetsExtReferenced(DefaultCategory));
+	FilterDuplicate = MakeShareable(new FPjcFilterAssetsDuplicate(DefaultCategory));
 
 	FilterUsed->OnFilterChanged().AddRaw(this, &SPjcTabAssetsUnused::OnFilterUsedChanged);
 	FilterPrimary->OnFilterChanged().AddRaw(this, &SPjcTabAssetsUnused::OnFilterPrimaryChanged);
@@ -203,6 +220,7 @@ void SPjcTabAssetsUnused::Construct(const FArguments& InArgs)
 	FilterEditor->OnFilterChanged().AddRaw(this, &SPjcTabAssetsUnused::OnFilterEditorChanged);
 	FilterExcluded->OnFilterChanged().AddRaw(this, &SPjcTabAssetsUnused::OnFilterExcludedChanged);
 	FilterExtReferenced->OnFilterChanged().AddRaw(this, &SPjcTabAssetsUnused::OnFilterExtReferencedChanged);
+	FilterDuplicate->OnFilterChanged().AddRaw(this, &SPjcTabAssetsUnused::OnFilterDuplicateChanged);
 
 	AssetPickerConfig.ExtraFrontendFilters.Emplace(FilterUsed.ToSharedRef());
 	AssetPickerConfig.ExtraFrontendFilters.Emplace(FilterPrimary.ToSharedRef());
@@ -211,6 +229,7 @@ void SPjcTabAssetsUnused::Construct(const FArguments& InArgs)
 	AssetPickerConfig.ExtraFrontendFilters.Emplace(FilterEditor.ToSharedRef());
 	AssetPickerConfig.ExtraFrontendFilters.Emplace(FilterExcluded.ToSharedRef());
 	AssetPickerConfig.ExtraFrontendFilters.Emplace(FilterExtReferenced.ToSharedRef());
+	AssetPickerConfig.ExtraFrontendFilters.Emplace(FilterDuplicate.ToSharedRef());
 
 	const auto ContentBrowserView = UPjcSubsystem::GetModuleContentBrowser().Get().CreateAssetPicker(AssetPickerConfig);
 
@@ -399,6 +418,11 @@ void SPjcTabAssetsUnused::Construct(const FArguments& InArgs)
 	];
 }
 
+SPjcTabAssetsUnused::~SPjcTabAssetsUnused()
+{
+	FPjcContentIndex::OnContentChanged().Remove(DelegateHandleContentChanged);
+}
+
 TSharedRef<SWidget> SPjcTabAssetsUnused::CreateToolbarMain() const
 {
 	FToolBarBuilder ToolBarBuilder{Cmds, FMultiBoxCustomization::None};
@@ -406,6 +430,9 @@ TSharedRef<SWidget> SPjcTabAssetsUnused::CreateToolbarMain() const
 	{
 		ToolBarBuilder.AddToolBarButton(FPjcCmds::Get().ScanProject);
 		ToolBarBuilder.AddToolBarButton(FPjcCmds::Get().CleanProject);
+		ToolBarBuilder.AddToolBarButton(FPjcCmds::Get().ResumeDeletion);
+		ToolBarBuilder.AddToolBarButton(FPjcCmds::Get().QuarantineProject);
+		ToolBarBuilder.AddToolBarButton(FPjcCmds::Get().QuarantineRestore);
 		ToolBarBuilder.AddSeparator();
 		ToolBarBuilder.AddToolBarButton(FPjcCmds::Get().ClearExcludeSettings);
 	}
@@ -471,6 +498,54 @@ void SPjcTabAssetsUnused::OnProjectClean()
 	ScanProject();
 }
 
+void SPjcTabAssetsUnused::OnProjectQuarantine()
+{
+	const FText Title = FText::FromString(TEXT("Project Quarantine"));
+	const FText Context = FText::FromString(TEXT("Are you sure you want to move all unused assets and external files to quarantine?"));
+
+	const EAppReturnType::Type ReturnType = FMessageDialog::Open(EAppMsgType::YesNo, Context, &Title);
+	if (ReturnType == EAppReturnType::Cancel || ReturnType == EAppReturnType::No) return;
+
+	UPjcSubsystem::QuarantineUnused(true, true);
+
+	ScanProject();
+}
+
+void SPjcTabAssetsUnused::OnDeletionResume()
+{
+	const FText Title = FText::FromString(TEXT("Resume Deletion"));
+	const FText Context = FText::FromString(TEXT("Previous deletion of unused assets was interrupted. Are you sure you want to continue it?"));
+
+	const EAppReturnType::Type ReturnType = FMessageDialog::Open(EAppMsgType::YesNo, Context, &Title);
+	if (ReturnType == EAppReturnType::Cancel || ReturnType == EAppReturnType::No) return;
+
+	UPjcSubsystem::DeleteAssetsUnusedResume(true, true);
+
+	ScanProject();
+}
+
+void SPjcTabAssetsUnused::OnQuarantineRestore()
+{
+	TArray<FString> QuarantineIds;
+	UPjcSubsystem::GetQuarantineIds(QuarantineIds);
+
+	if (QuarantineIds.Num() == 0)
+	{
+		UPjcSubsystem::ShowNotification(TEXT("There is no quarantine to restore"), SNotificationItem::CS_None, 3.0f);
+		return;
+	}
+
+	const FText Title = FText::FromString(TEXT("Restore Quarantine"));
+	const FText Context = FText::FromString(FString::Printf(TEXT("Are you sure you want to restore all files from quarantine %s?"), *QuarantineIds.Last()));
+
+	const EAppReturnType::Type ReturnType = FMessageDialog::Open(EAppMsgType::YesNo, Context, &Title);
+	if (ReturnType == EAppReturnType::Cancel || ReturnType == EAppReturnType::No) return;
+
+	UPjcSubsystem::QuarantineRestore(QuarantineIds.Last(), true, true);
+
+	ScanProject();
+}
+
 void SPjcTabAssetsUnused::OnResetExcludeSettings()
 {
 	UPjcAssetExcludeSettings* AssetExcludeSettings = GetMutableDefault<UPjcAssetExcludeSettings>();
@@ -884,8 +959,6 @@ void SPjcTabAssetsUnused::ScanProject()
 
 	SlowTaskMain.EnterProgressFrame(1.0f);
 
-	TArray<FString> FoldersTotal;
-	TArray<FString> FoldersEmpty;
 	TArray<FPjcAssetIndirectInfo> AssetIndirectInfos;
 	UPjcSubsystem::GetAssetsAll(AssetsAll);
 	UPjcSubsystem::GetAssetsUsed(AssetsUsed);
@@ -896,8 +969,6 @@ void SPjcTabAssetsUnused::ScanProject()
 	UPjcSubsystem::GetAssetsEditor(AssetsEditor);
 	UPjcSubsystem::GetAssetsExcluded(AssetsExcluded);
 	UPjcSubsystem::GetAssetsExtReferenced(AssetsExtReferenced);
-	UPjcSubsystem::GetFolders(FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir()), true, FoldersTotal);
-	UPjcSubsystem::GetFoldersEmpty(FoldersEmpty);
 
 	FilterUsed->UpdateData();
 	FilterPrimary->UpdateData();
@@ -907,6 +978,13 @@ void SPjcTabAssetsUnused::ScanProject()
 	FilterExcluded->UpdateData();
 	FilterExtReferenced->UpdateData();
 
+	// duplicate files are hashed only while their filter is active, not on every scan
+	if (bFilterAssetsDuplicateActive)
+	{
+		FilterDuplicate->UpdateData();
+		UpdateAssetsDuplicate();
+	}
+
 	for (const FAssetData& Asset : AssetsAll)
 	{
 		const FString AssetPath = Asset.PackagePath.ToString();
@@ -933,13 +1011,12 @@ void SPjcTabAssetsUnused::ScanProject()
 	NumAssetsAll = AssetsAll.Num();
 	NumAssetsUsed = AssetsUsed.Num();
 	NumAssetsUnused = AssetsUnused.Num();
+	bDeletionResumable = UPjcSubsystem::DeletionCanResume();
 	NumAssetsPrimary = AssetsPrimary.Num();
 	NumAssetsIndirect = AssetsIndirect.Num();
 	NumAssetsEditor = AssetsEditor.Num();
 	NumAssetsExcluded = AssetsExcluded.Num();
 	NumAssetsExtReferenced = AssetsExtReferenced.Num();
-	NumFoldersTotal = FoldersTotal.Num();
-	NumFoldersEmpty = FoldersEmpty.Num();
 
 	SizeAssetsAll = UPjcSubsystem::GetAssetsTotalSize(AssetsAll);
 	SizeAssetsUsed = UPjcSubsystem::GetAssetsTotalSize(AssetsUsed);
@@ -950,6 +1027,8 @@ void SPjcTabAssetsUnused::ScanProject()
 	SizeAssetsExcluded = UPjcSubsystem::GetAssetsTotalSize(AssetsExcluded);
 	SizeAssetsExtReferenced = UPjcSubsystem::GetAssetsTotalSize(AssetsExtReferenced);
 
+	UpdateFoldersData();
+
 	const double ScanTime = FPlatformTime::Seconds() - ScanStartTime;
 
 	UE_LOG(LogProjectCleaner, Display, TEXT("Project assets scanned in %.2f seconds."), ScanTime);
@@ -961,6 +1040,24 @@ void SPjcTabAssetsUnused::ScanProject()
 	UpdateContentBrowser();
 }
 
+void SPjcTabAssetsUnused::UpdateFoldersData()
+{
+	TArray<FString> FoldersEmpty;
+	UPjcSubsystem::GetFoldersEmpty(FoldersEmpty);
+
+	// content folder itself is not counted
+	NumFoldersTotal = FMath::Max(0, FPjcContentIndex::Get().GetFolders().Num() - 1);
+	NumFoldersEmpty = FoldersEmpty.Num();
+}
+
+void SPjcTabAssetsUnused::OnContentChanged()
+{
+	// assets data is updated only by project scan, folders data comes from content table, that is already up to date
+	UpdateFoldersData();
+	UpdateStats();
+	UpdateTreeView();
+}
+
 void SPjcTabAssetsUnused::UpdateStats()
 {
 	StatsListItems.Reset();
@@ -1061,6 +1158,21 @@ void SPjcTabAssetsUnused::UpdateStats()
 		)
 	);
 
+	StatsListItems.Emplace(
+		MakeShareable(
+			new FPjcStatItem{
+				FText::FromString(TEXT("Duplicate")),
+				bAssetsDuplicateScanned ? FText::AsNumber(NumAssetsDuplicate) : FText::FromString(TEXT("-")),
+				bAssetsDuplicateScanned ? FText::AsMemory(SizeAssetsDuplicate, IEC) : FText::FromString(TEXT("-")),
+				FText::FromString(TEXT("Assets that are byte identical to other assets or imported from same source files. Activate Assets Duplicate filter to search for them.")),
+				FText::FromString(TEXT("Total number of Duplicate assets")),
+				FText::FromString(TEXT("Size that can be reclaimed by keeping only one file of every duplicate group")),
+				FLinearColor::White,
+				SecondLvl
+			}
+		)
+	);
+
 	StatsListItems.Emplace(
 		MakeShareable(
 			new FPjcStatItem{
@@ -1110,6 +1222,12 @@ void SPjcTabAssetsUnused::UpdateTreeView()
 	TSet<TSharedPtr<FPjcTreeItem>> CachedExpandedItems;
 	TreeListView->GetExpandedItems(CachedExpandedItems);
 
+	// empty state and disk usage of all folders computed once, instead of checking every tree item separately
+	const FPjcContentIndex& ContentIndex = FPjcContentIndex::Get();
+	TArray<bool> FoldersEmptyFlags;
+	TArray<FPjcFolderDiskUsage> FoldersDiskUsage;
+	UPjcSubsystem::GetFoldersEmptyFlags(FoldersEmptyFlags);
+	UPjcSubsystem::GetFoldersDiskUsage(AssetsUnused, FoldersDiskUsage);
 
 	RootItem->FolderPath = PjcConstants::PathRoot.ToString();
 	RootItem->FolderName = TEXT("Content");
@@ -1122,7 +1240,9 @@ void SPjcTabAssetsUnused::UpdateTreeView()
 	RootItem->NumAssetsTotal = AssetsAll.Num();
 	RootItem->NumAssetsUsed = AssetsUsed.Num();
 	RootItem->NumAssetsUnused = AssetsUnused.Num();
-	RootItem->SizeAssetsUnused = UPjcSubsystem::GetAssetsTotalSize(AssetsUnused);
+	// content folder is always first folder of content table
+	RootItem->DiskUsage = FoldersDiskUsage[0];
+	RootItem->SizeAssetsUnused = FoldersDiskUsage[0].SizeUnused;
 	RootItem->PercentageUnused = RootItem->NumAssetsTotal == 0 ? 0 : RootItem->NumAssetsUnused * 100.0f / RootItem->NumAssetsTotal;
 	RootItem->PercentageUnusedNormalized = FMath::GetMappedRangeValueClamped(FVector2D{0.0f, 100.0f}, FVector2D{0.0f, 1.0f}, RootItem->PercentageUnused);
 	RootItem->Parent = nullptr;
@@ -1150,16 +1270,20 @@ void SPjcTabAssetsUnused::UpdateTreeView()
 			const TSharedPtr<FPjcTreeItem> SubItem = MakeShareable(new FPjcTreeItem);
 			if (!SubItem.IsValid()) continue;
 
+			// folders that exist only in asset registry are not in content table
+			const int32 FolderIndex = ContentIndex.FindFolderIndex(UPjcSubsystem::PathConvertToAbsolute(SubPath));
+
 			SubItem->FolderPath = SubPath;
 			SubItem->FolderName = FPaths::GetPathLeaf(SubItem->FolderPath);
 			SubItem->bIsDev = SubItem->FolderPath.StartsWith(PjcConstants::PathDevelopers.ToString());
 			SubItem->bIsRoot = false;
-			SubItem->bIsEmpty = UPjcSubsystem::FolderIsEmpty(SubItem->FolderPath);
+			SubItem->bIsEmpty = FolderIndex == INDEX_NONE ? UPjcSubsystem::FolderIsEmpty(SubItem->FolderPath) : FoldersEmptyFlags[FolderIndex];
 			SubItem->bIsExcluded = UPjcSubsystem::FolderIsExcluded(SubItem->FolderPath);
 			SubItem->NumAssetsTotal = MapNumAssetsAllByPath.Contains(SubItem->FolderPath) ? MapNumAssetsAllByPath[SubItem->FolderPath] : 0;
 			SubItem->NumAssetsUsed = MapNumAssetsUsedByPath.Contains(SubItem->FolderPath) ? MapNumAssetsUsedByPath[SubItem->FolderPath] : 0;
 			SubItem->NumAssetsUnused = MapNumAssetsUnusedByPath.Contains(SubItem->FolderPath) ? MapNumAssetsUnusedByPath[SubItem->FolderPath] : 0;
-			SubItem->SizeAssetsUnused = MapSizeAssetsUnusedByPath.Contains(SubItem->FolderPath) ? MapSizeAssetsUnusedByPath[SubItem->FolderPath] : 0.0f;
+			SubItem->DiskUsage = FolderIndex == INDEX_NONE ? FPjcFolderDiskUsage{} : FoldersDiskUsage[FolderIndex];
+			SubItem->SizeAssetsUnused = FolderIndex == INDEX_NONE ? 0.0f : FoldersDiskUsage[FolderIndex].SizeUnused;
 			SubItem->PercentageUnused = SubItem->NumAssetsTotal == 0 ? 0 : SubItem->NumAssetsUnused * 100.0f / SubItem->NumAssetsTotal;
 			SubItem->PercentageUnusedNormalized = FMath::GetMappedRangeValueClamped(FVector2D{0.0f, 100.0f}, FVector2D{0.0f, 1.0f}, SubItem->PercentageUnused);
 			SubItem->Parent = CurrentItem;
@@ -1264,6 +1388,16 @@ void SPjcTabAssetsUnused::UpdateContentBrowser()
 			}
 		}
 
+		if (bFilterAssetsDuplicateActive)
+		{
+			Filter.ObjectPaths.Reserve(Filter.ObjectPaths.Num() + AssetsDuplicate.Num());
+
+			for (const auto& Asset : AssetsDuplicate)
+			{
+				Filter.ObjectPaths.Emplace(Asset.ToSoftObjectPath().GetAssetPathName());
+			}
+		}
+
 		DelegateFilter.Execute(Filter);
 
 		return;
@@ -1419,6 +1553,16 @@ void SPjcTabAssetsUnused::SortTreeItems(const bool UpdateSortingOrder)
 			return ColumnUnusedSizeSortMode == EColumnSortMode::Ascending ? Item1->SizeAssetsUnused < Item2->SizeAssetsUnused : Item1->SizeAssetsUnused > Item2->SizeAssetsUnused;
 		});
 	}
+
+	if (LastSortedColumn.IsEqual(TEXT("DiskSize")))
+	{
+		SortTreeItems(ColumnDiskSizeSortMode, [&](const TSharedPtr<FPjcTreeItem>& Item1, const TSharedPtr<FPjcTreeItem>& Item2)
+		{
+			const int64 Size1 = Item1->DiskUsage.GetSizeTotal();
+			const int64 Size2 = Item2->DiskUsage.GetSizeTotal();
+			return ColumnDiskSizeSortMode == EColumnSortMode::Ascending ? Size1 < Size2 : Size1 > Size2;
+		});
+	}
 }
 
 void SPjcTabAssetsUnused::ChangeItemExpansionRecursive(const TSharedPtr<FPjcTreeItem>& Item, const bool bExpansion, const bool bRebuildList) const
@@ -1528,6 +1672,11 @@ bool SPjcTabAssetsUnused::CanCleanProject() const
 	return NumAssetsUnused > 0 || NumFoldersEmpty > 0;
 }
 
+bool SPjcTabAssetsUnused::CanResumeDeletion() const
+{
+	return bDeletionResumable;
+}
+
 bool SPjcTabAssetsUnused::CanDeleteEmptyFolders() const
 {
 	return NumFoldersEmpty > 0;
@@ -1541,7 +1690,8 @@ bool SPjcTabAssetsUnused::AnyFilterActive() const
 		bFilterAssetsEditorActive ||
 		bFilterAssetsIndirectActive ||
 		bFilterAssetsExcludedActive ||
-		bFilterAssetsExtReferencedActive;
+		bFilterAssetsExtReferencedActive ||
+		bFilterAssetsDuplicateActive;
 }
 
 bool SPjcTabAssetsUnused::AnyAssetSelected() const
@@ -1785,7 +1935,7 @@ TSharedRef<SHeaderRow> SPjcTabAssetsUnused::GetTreeHeaderRow()
 			.HAlignHeader(HAlign_Center)
 			.VAlignHeader(VAlign_Center)
 			.HeaderContentPadding(HeaderMargin)
-			.FillWidth(0.4f)
+			.FillWidth(0.3f)
 			.OnSort_Raw(this, &SPjcTabAssetsUnused::OnTreeSort)
 			[
 				SNew(STextBlock)
@@ -1855,7 +2005,20 @@ TSharedRef<SHeaderRow> SPjcTabAssetsUnused::GetTreeHeaderRow()
 			[
 				SNew(STextBlock)
 				.Text(FText::FromString(TEXT("Unused Size")))
-				.ToolTipText(FText::FromString(TEXT("Total size of unused assets in current path")))
+				.ToolTipText(FText::FromString(TEXT("Total size of unused assets files on disk in current path")))
+				.ColorAndOpacity(FPjcStyles::Get().GetSlateColor("ProjectCleaner.Color.Green"))
+				.Font(FPjcStyles::GetFont("Light", 10.0f))
+			]
+			+ SHeaderRow::Column(TEXT("DiskSize"))
+			.HAlignHeader(HAlign_Center)
+			.VAlignHeader(VAlign_Center)
+			.HeaderContentPadding(HeaderMargin)
+			.FillWidth(0.1f)
+			.OnSort_Raw(this, &SPjcTabAssetsUnused::OnTreeSort)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(TEXT("Disk Size")))
+				.ToolTipText(FText::FromString(TEXT("Total size of all files on disk in current path, including external and sidecar files")))
 				.ColorAndOpacity(FPjcStyles::Get().GetSlateColor("ProjectCleaner.Color.Green"))
 				.Font(FPjcStyles::GetFont("Light", 10.0f))
 			];
@@ -1927,6 +2090,29 @@ void SPjcTabAssetsUnused::OnFilterExtReferencedChanged(const bool bActive)
 	UpdateContentBrowser();
 }
 
+void SPjcTabAssetsUnused::OnFilterDuplicateChanged(const bool bActive)
+{
+	bFilterAssetsDuplicateActive = bActive;
+	bFilterAssetsUnusedActive = !AnyFilterActive();
+
+	// filter searched duplicates right before broadcasting, so its results are reused instead of hashing files again
+	if (bActive)
+	{
+		UpdateAssetsDuplicate();
+		UpdateStats();
+	}
+
+	UpdateContentBrowser();
+}
+
+void SPjcTabAssetsUnused::UpdateAssetsDuplicate()
+{
+	AssetsDuplicate = FilterDuplicate->GetAssets().Array();
+	NumAssetsDuplicate = AssetsDuplicate.Num();
+	SizeAssetsDuplicate = FilterDuplicate->GetSizeReclaimable();
+	bAssetsDuplicateScanned = true;
+}
+
 void SPjcTabAssetsUnused::OnAssetDblClicked(const FAssetData& AssetData)
 {
 	UPjcSubsystem::OpenAssetEditor(AssetData);
@@ -2007,6 +2193,7 @@ void SPjcTabAssetsUnused::ResetFilters()
 	bFilterAssetsExcludedActive = false;
 	bFilterAssetsExtReferencedActive = false;
 	bFilterAssetsCircularActive = false;
+	bFilterAssetsDuplicateActive = false;
 	bFilterAssetsUnusedActive = true;
 }
 
@@ -2021,6 +2208,8 @@ void SPjcTabAssetsUnused::ResetCachedData()
 	AssetsEditor.Reset();
 	AssetsExcluded.Reset();
 	AssetsExtReferenced.Reset();
+	AssetsDuplicate.Reset();
+	bAssetsDuplicateScanned = false;
 	MapNumAssetsAllByPath.Reset();
 	MapNumAssetsUsedByPath.Reset();
 	MapNumAssetsUnusedByPath.Reset();
@@ -2036,6 +2225,7 @@ void SPjcTabAssetsUnused::ResetCachedData()
 	NumAssetsEditor = 0;
 	NumAssetsExcluded = 0;
 	NumAssetsExtReferenced = 0;
+	NumAssetsDuplicate = 0;
 	NumFoldersTotal = 0;
 	NumFoldersEmpty = 0;
 
@@ -2047,6 +2237,7 @@ void SPjcTabAssetsUnused::ResetCachedData()
 	SizeAssetsEditor = 0;
 	SizeAssetsExcluded = 0;
 	SizeAssetsExtReferenced = 0;
+	SizeAssetsDuplicate = 0;
 }
 
 void SPjcTabAssetsUnused::UpdateMapInfo(TMap<FString, int32>& MapNum, TMap<FString, int64>& MapSize, const FString& AssetPath, int64 AssetSize)
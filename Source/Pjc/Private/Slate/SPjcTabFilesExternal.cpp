@@ -6,6 +6,7 @@
 #include "PjcStyles.h"
 #include "PjcSubsystem.h"
 #include "PjcConstants.h"
+#include "PjcContentIndex.h"
 // Engine Headers
 #include "Widgets/Input/SSearchBox.h"
 #include "Widgets/Layout/SScrollBox.h"
@@ -18,6 +19,8 @@ void SPjcTabFilesExternal::Construct(const FArguments& InArgs)
 
 	Cmds = MakeShareable(new FUICommandList);
 
+	DelegateHandleContentChanged = FPjcContentIndex::OnContentChanged().AddRaw(this, &SPjcTabFilesExternal::OnContentChanged);
+
 	Cmds->MapAction(
 		FPjcCmds::Get().Refresh,
 		FExecuteAction::CreateRaw(this, &SPjcTabFilesExternal::OnRefresh)
@@ -202,6 +205,11 @@ void SPjcTabFilesExternal::Construct(const FArguments& InArgs)
 	];
 }
 
+SPjcTabFilesExternal::~SPjcTabFilesExternal()
+{
+	FPjcContentIndex::OnContentChanged().Remove(DelegateHandleContentChanged);
+}
+
 void SPjcTabFilesExternal::ListUpdateData()
 {
 	TArray<FString> FilesExternalAll;
@@ -222,7 +230,7 @@ void SPjcTabFilesExternal::ListUpdateData()
 	{
 		const FString FileName = FPaths::GetBaseFilename(File);
 		const FString FileExt = FPaths::GetExtension(File, false).ToLower();
-		const int64 FileSize = IFileManager::Get().FileSize(*File);
+		const int64 FileSize = UPjcSubsystem::GetFileSize(File);
 		const bool bExcluded = FilesExternalExcluded.Contains(File);
 
 		SizeFilesTotal += FileSize;
@@ -514,6 +522,12 @@ void SPjcTabFilesExternal::OnRefresh()
 	ListUpdateView();
 }
 
+void SPjcTabFilesExternal::OnContentChanged()
+{
+	ListUpdateData();
+	ListUpdateView();
+}
+
 void SPjcTabFilesExternal::OnDelete()
 {
 	UPjcFileExcludeSettings* FileExcludeSettings = GetMutableDefault<UPjcFileExcludeSettings>();
@@ -521,30 +535,37 @@ void SPjcTabFilesExternal::OnDelete()
 
 	const auto ItemsSelected = ListView->GetSelectedItems();
 	const int32 NumTotal = ItemsSelected.Num();
-	int32 NumDeleted = 0;
 	const FText Title = FText::FromString(TEXT("Delete External Files"));
 	const FText Context = FText::FromString(TEXT("Are you sure you want to delete selected files?"));
 
 	const EAppReturnType::Type ReturnType = FMessageDialog::Open(EAppMsgType::YesNo, Context, &Title);
 	if (ReturnType == EAppReturnType::Cancel || ReturnType == EAppReturnType::No) return;
 
+	TArray<FString> Files;
+	Files.Reserve(NumTotal);
+
 	for (const auto& Item : ItemsSelected)
 	{
 		if (!Item.IsValid() || !FPaths::FileExists(Item->FilePath)) continue;
-		if (!IFileManager::Get().Delete(*Item->FilePath, true)) continue;
 
-		if (Item->bExcluded)
-		{
-			FileExcludeSettings->ExcludedFiles.RemoveAllSwap([&](const FFilePath& InFile)
-			{
-				FString Path = Item->FilePath;
-				Path.RemoveFromStart(FPaths::ConvertRelativePathToFull(FPaths::ProjectDir()));
+		Files.Add(Item->FilePath);
+	}
 
-				return InFile.FilePath.Equals(Path);
-			}, false);
-		}
+	const int32 NumDeleted = UPjcSubsystem::FilesDelete(Files, TEXT("Deleting external files ..."), true);
+
+	// exclusion entries of deleted files are removed, files that failed to delete keep theirs
+	const FString ProjectDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir());
+	for (const auto& Item : ItemsSelected)
+	{
+		if (!Item.IsValid() || !Item->bExcluded || FPaths::FileExists(Item->FilePath)) continue;
 
-		++NumDeleted;
+		FString Path = Item->FilePath;
+		Path.RemoveFromStart(ProjectDir);
+
+		FileExcludeSettings->ExcludedFiles.RemoveAllSwap([&](const FFilePath& InFile)
+		{
+			return InFile.FilePath.Equals(Path);
+		}, false);
 	}
 
 	FileExcludeSettings->PostEditChange();
@@ -5,6 +5,10 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleInterface.h"
 
+class FExtender;
+class FMenuBuilder;
+struct FAssetData;
+
 DECLARE_LOG_CATEGORY_EXTERN(LogProjectCleaner, Log, All);
 
 class FPjc final : public IModuleInterface
@@ -16,5 +20,9 @@ public:
 	virtual bool IsGameModule() const override;
 
 private:
+	static TSharedRef<FExtender> OnExtendContentBrowserAssetMenu(const TArray<FAssetData>& SelectedAssets);
+	static void CreateIndirectReferencesMenu(FMenuBuilder& MenuBuilder, TArray<FAssetData> SelectedAssets);
+
 	TSharedPtr<FUICommandList> Cmds;
+	FDelegateHandle ContentBrowserExtenderHandle;
 };
@@ -23,6 +23,9 @@ public:
 
 	TSharedPtr<FUICommandInfo> ScanProject;
 	TSharedPtr<FUICommandInfo> CleanProject;
+	TSharedPtr<FUICommandInfo> ResumeDeletion;
+	TSharedPtr<FUICommandInfo> QuarantineProject;
+	TSharedPtr<FUICommandInfo> QuarantineRestore;
 	TSharedPtr<FUICommandInfo> DeleteEmptyFolders;
 	TSharedPtr<FUICommandInfo> ClearExcludeSettings;
 	TSharedPtr<FUICommandInfo> PathsExclude;
@@ -20,6 +20,12 @@ namespace PjcConstants
 	static FName PathRoot{TEXT("/Game")};
 	static FName PathDevelopers{TEXT("/Game/Developers")};
 	static FName PathMSPresets{TEXT("/Game/MSPresets")};
+	static const FString PathSavedDirName{TEXT("ProjectCleaner")};
+	static const FString PathQuarantineDirName{TEXT("Quarantine")};
+	static const FString FileScanCacheName{TEXT("IndirectScanCache.bin")};
+	static const FString FileIndirectIndexName{TEXT("IndirectIndex.bin")};
+	static const FString FileDeletionPlanName{TEXT("DeletionPlan.json")};
+	static const FString FileDeletionJournalName{TEXT("DeletionJournal.txt")};
 
 	// tabs
 	static const FName TabProjectCleaner{TEXT("TabProjectCleaner")};
@@ -34,10 +40,23 @@ namespace PjcConstants
 
 	// misc
 	static constexpr int32 BucketSize = 500;
+	static constexpr int32 BucketSizeMin = 16;
+	static constexpr int32 BucketSizeMax = 4000;
+	static constexpr double DeleteMemoryBudgetRatio = 0.6;
+	static constexpr double DeleteMemoryWatermark = 0.8;
+	static constexpr int32 DeleteBatchSize = 256;
+	static constexpr int32 DeleteWorkersMax = 8;
+	static constexpr float ContentChangedDelay = 0.5f;
+	static constexpr double ContentChangedDelayMax = 10.0;
 	static const FName EmptyTagName{TEXT("PjcEmptyTag")};
 	static const TSet<FString> EngineFileExtensions{TEXT("umap"), TEXT("uasset"), TEXT("collection")};
+	static const TSet<FString> PackageFileExtensions{TEXT("umap"), TEXT("uasset")};
+	static const TSet<FString> SidecarFileExtensions{TEXT("uexp"), TEXT("ubulk"), TEXT("uptnl")};
 	static const TSet<FString> SourceFileExtensions{TEXT("cpp"), TEXT("h"), TEXT("cs")};
 	static const TSet<FString> ConfigFileExtensions{TEXT("ini")};
+	static const TSet<FString> ScriptFileExtensions{TEXT("py")};
+	static const TSet<FString> DataFileExtensions{TEXT("csv"), TEXT("json")};
+	static const TSet<FString> ProjectFileExtensions{TEXT("uproject"), TEXT("uplugin")};
 	static const FString UrlGithub{TEXT("https://github.com/ashe23/ProjectCleaner")};
 	static const FString UrlDocs{TEXT("https://github.com/ashe23/ProjectCleaner/wiki")};
 	static const FString UrlIssueTracker{TEXT("https://github.com/ashe23/ProjectCleaner/issues")};
@@ -0,0 +1,113 @@
+﻿// Copyright Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FFileChangeData;
+
+DECLARE_MULTICAST_DELEGATE(FPjcDelegateContentChanged);
+
+struct FPjcContentFile
+{
+	FString Path;
+	int64 Size = 0;
+	FDateTime Time;
+	int32 ExtId = INDEX_NONE;
+	int32 FolderIndex = INDEX_NONE;
+};
+
+struct FPjcContentFolder
+{
+	FString Path;
+	int32 ParentIndex = INDEX_NONE;
+	int32 NumFiles = 0;
+	int32 NumFilesTotal = 0;
+	bool bEmpty = true;
+};
+
+/**
+ * @brief Table of all files and folders in Content folder, built by single parallel stat returning directory walk.
+ * External files, corrupted files, empty folders and file sizes are all queried from same table.
+ * Table is rebuilt at most once per frame or after any files were deleted by plugin.
+ * In live mode table is updated by directory watcher events instead and rebuilt only when folder structure changes.
+ */
+class FPjcContentIndex
+{
+public:
+	/**
+	 * @brief Returns up to date content table, rebuilding it if needed. Must be called from game thread.
+	 * @return const FPjcContentIndex&
+	 */
+	static const FPjcContentIndex& Get();
+
+	/**
+	 * @brief Forces table rebuild on next Get call. Must be called after any file or folder was created or deleted in Content folder.
+	 */
+	static void MarkDirty();
+
+	/**
+	 * @brief Applies file system changes reported by directory watcher without walking Content folder again.
+	 * Added, modified and removed files are applied in place, added or removed folders cause rebuild on next Get call.
+	 * @param InChanges TArray<FFileChangeData>
+	 */
+	static void ApplyChanges(const TArray<FFileChangeData>& InChanges);
+
+	/**
+	 * @brief Enables or disables live mode. Must be enabled only while Content folder is watched by directory watcher.
+	 * @param bInLive bool
+	 */
+	static void SetLive(const bool bInLive);
+
+	/**
+	 * @brief Broadcasts after files in Content folder were changed on disk.
+	 * Directory watcher changes are coalesced and broadcast once they settle and AssetRegistry finished gathering changed files.
+	 * @return FPjcDelegateContentChanged&
+	 */
+	static FPjcDelegateContentChanged& OnContentChanged();
+
+	const TArray<FPjcContentFile>& GetFiles() const;
+	const TArray<FPjcContentFolder>& GetFolders() const;
+	const FPjcContentFile* FindFile(const FString& InFilePath) const;
+	const FPjcContentFolder* FindFolder(const FString& InFolderPath) const;
+	int32 FindFolderIndex(const FString& InFolderPath) const;
+
+	/**
+	 * @brief Returns extension id of given extension (case insensitive, without dot) or INDEX_NONE if no file has such extension
+	 * @param InExt FString
+	 * @return int32
+	 */
+	int32 GetExtId(const FString& InExt) const;
+	const FString& GetExt(const int32 InExtId) const;
+
+	/**
+	 * @brief Returns extension ids of all given extensions, that exists in table
+	 * @param InExtensions TSet<FString>
+	 * @return TSet<int32>
+	 */
+	TSet<int32> GetExtIds(const TSet<FString>& InExtensions) const;
+
+private:
+	void Build();
+	bool ApplyChange(const FFileChangeData& InChange);
+	void AddFileCount(const int32 InFolderIndex, const int32 InDelta);
+
+	static void BroadcastDeferred();
+	static bool BroadcastTick(float InDeltaTime);
+	static bool IsAssetRegistryBusy();
+
+	TArray<FPjcContentFile> Files;
+	TArray<FPjcContentFolder> Folders;
+	TArray<FString> Extensions;
+	TMap<FString, int32> ExtIds;
+	TMap<FString, int32> FileIndices;
+	TMap<FString, int32> FolderIndices;
+	// engine generated folders, that are not walked and whose changes are ignored
+	TArray<FString> FoldersPruned;
+
+	static FPjcContentIndex Instance;
+	static uint64 BuildFrame;
+	static bool bDirty;
+	static bool bLive;
+	static FPjcDelegateContentChanged DelegateContentChanged;
+};
@@ -0,0 +1,54 @@
+﻿// Copyright Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FPjcDeletionPlan;
+
+/**
+ * @brief Append only journal of running deletion, stored under Saved/ProjectCleaner.
+ * Journal starts with all planned assets in deletion order, then every finished slice appends position in plan, up to which all assets are deleted.
+ * File is flushed after every line, so after crash interrupted deletion can be resumed from last committed slice.
+ * Journal is removed once deletion finishes.
+ */
+class FPjcDeletionJournal
+{
+public:
+	~FPjcDeletionJournal();
+
+	/**
+	 * @brief Replaces any existing journal with new one for given plan
+	 * @param InPlan FPjcDeletionPlan
+	 * @return bool
+	 */
+	bool Begin(const FPjcDeletionPlan& InPlan);
+
+	/**
+	 * @brief Records that all planned assets before given position are deleted
+	 * @param InNumAssetsDeleted int32 - Position in plan
+	 */
+	void Commit(const int32 InNumAssetsDeleted);
+
+	/**
+	 * @brief Closes and removes journal after deletion finished
+	 */
+	void Finish();
+
+	/**
+	 * @brief Reads journal of interrupted deletion. Journal that was not fully written is ignored, nothing could be deleted before that.
+	 * @param OutObjectPaths TArray<FName> - Planned assets in deletion order
+	 * @param OutNumAssetsCommitted int32 - Number of planned assets, that were deleted
+	 * @return bool - false if there is no interrupted deletion
+	 */
+	static bool Read(TArray<FName>& OutObjectPaths, int32& OutNumAssetsCommitted);
+
+	static bool Exists();
+	static void Discard();
+	static FString GetJournalFilePath();
+
+private:
+	void WriteLine(const FString& InLine);
+
+	TUniquePtr<FArchive> Writer;
+};
@@ -0,0 +1,89 @@
+﻿// Copyright Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FPjcDeletionPlanFile
+{
+	FString Path;
+	int64 Size = 0;
+	FDateTime Time;
+};
+
+/**
+ * @brief Order in which unused assets are deleted, computed once before deletion starts.
+ * Asset is always deleted together with or after all assets that reference it, so every deleted bucket has no remaining referencers.
+ * Assets that reference each other in cycle are kept in same bucket.
+ * Plan is computed without loading any package and can be saved to json file, so it can be reviewed and executed later.
+ */
+class FPjcDeletionPlan
+{
+public:
+	/**
+	 * @brief Builds deletion order from referencers graph of given assets. Cycles are collapsed into single nodes (Tarjan)
+	 * and resulting graph is ordered from assets without referencers to most referenced ones (Kahn).
+	 * Order is then sliced into buckets of given size, cycle is never split between buckets, so bucket can be bigger than given size.
+	 * @param InAssets TArray<FAssetData>
+	 * @param InBucketSize int32
+	 */
+	void Build(const TArray<FAssetData>& InAssets, const int32 InBucketSize);
+
+	/**
+	 * @brief Writes plan to json file. Besides buckets, file contains every deleted file with its size and time, total size of deleted files,
+	 * affected folders and folders that become empty after deletion.
+	 * @param InFilePath FString
+	 * @return bool
+	 */
+	bool Save(const FString& InFilePath) const;
+
+	/**
+	 * @brief Reads plan from json file written by Save. Planned assets are resolved through asset registry, nothing is loaded.
+	 * @param InFilePath FString
+	 * @return bool - false if file can not be read, was written by different version or any planned asset no longer exists
+	 */
+	bool Load(const FString& InFilePath);
+
+	/**
+	 * @brief Checks that plan still matches project. Set of unused assets must be same as planned and every planned file must have same size and time.
+	 * @param InAssetsUnused TArray<FAssetData> - Current unused assets
+	 * @param OutErrors TArray<FString>
+	 * @return bool
+	 */
+	bool Verify(const TArray<FAssetData>& InAssetsUnused, TArray<FString>& OutErrors) const;
+
+	int32 GetNumAssets() const;
+	int32 GetNumBuckets() const;
+	int64 GetSizeTotal() const;
+	const TArray<FString>& GetFoldersAffected() const;
+	const TArray<FString>& GetFoldersEmptyPredicted() const;
+
+	/**
+	 * @brief Returns assets of given bucket. Buckets must be deleted in order.
+	 * @param InBucketIndex int32
+	 * @return TArrayView<const FAssetData>
+	 */
+	TArrayView<const FAssetData> GetBucket(const int32 InBucketIndex) const;
+
+	/**
+	 * @brief Returns end of slice, that starts at InStart and contains at most InMaxSize assets. Slice always ends at component boundary,
+	 * so assets that reference each other are never split. If first component alone is bigger than InMaxSize, slice contains just that component.
+	 * Allows deleting plan in slices of changing size, InStart must be 0 or end of previous slice.
+	 * @param InStart int32
+	 * @param InMaxSize int32
+	 * @return int32
+	 */
+	int32 GetSliceEnd(const int32 InStart, const int32 InMaxSize) const;
+	TArrayView<const FAssetData> GetSlice(const int32 InStart, const int32 InEnd) const;
+
+private:
+	void BuildEstimate();
+
+	TArray<FAssetData> Assets;
+	TArray<int32> BucketStarts;
+	TArray<int32> ComponentStarts;
+	TArray<FPjcDeletionPlanFile> Files;
+	TArray<FString> FoldersAffected;
+	TArray<FString> FoldersEmptyPredicted;
+	int64 SizeTotal = 0;
+};
@@ -0,0 +1,48 @@
+﻿// Copyright Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+
+struct FPjcDirectoryEntry
+{
+	FString Path;
+	// valid only if walker was created with bInStat
+	FFileStatData StatData;
+};
+
+/**
+ * @brief Parallel directory walker. Every subdirectory becomes separate task in work stealing queues,
+ * so slow directory listings (network drives, cold disk cache) are waited in parallel.
+ * Walked paths are absolute, as root path is converted to full path once before walk.
+ */
+class FPjcDirectoryWalker
+{
+public:
+	/**
+	 * @brief Returns true if given folder and its whole subtree must not be walked. Called from multiple threads.
+	 */
+	using FPruneFunc = TFunction<bool(const FString& InFolderPath)>;
+
+	explicit FPjcDirectoryWalker(const bool bInRecursive, const bool bInStat = false);
+
+	/**
+	 * @brief Sets predicate for skipping folders. Pruned folders are not reported and never listed.
+	 * @param InPruneFunc FPruneFunc
+	 */
+	void SetPrune(FPruneFunc InPruneFunc);
+
+	/**
+	 * @brief Walks given folder. Results are sorted by path, so every folder comes before its content.
+	 * @param InRootPath FString
+	 * @param OutFiles TArray<FPjcDirectoryEntry>
+	 * @param OutFolders TArray<FPjcDirectoryEntry>
+	 */
+	void Walk(const FString& InRootPath, TArray<FPjcDirectoryEntry>& OutFiles, TArray<FPjcDirectoryEntry>& OutFolders) const;
+
+private:
+	bool bRecursive = true;
+	bool bStat = false;
+	FPruneFunc PruneFunc;
+};
@@ -0,0 +1,32 @@
+﻿// Copyright Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PjcTypes.h"
+
+/**
+ * @brief Finds duplicated content in Content folder.
+ * Files are grouped by size from content table first, so only files that share size with some other file are read and hashed.
+ * Hashes are cached by file size and time, so unchanged files are not read again.
+ */
+class FPjcDuplicateFinder
+{
+public:
+	/**
+	 * @brief Finds groups of byte identical files. Files are hashed in parallel by streaming reads.
+	 * @param OutGroups TArray<FPjcDuplicateGroup>
+	 * @param bShowSlowTask bool
+	 */
+	static void FindFiles(TArray<FPjcDuplicateGroup>& OutGroups, const bool bShowSlowTask);
+
+	/**
+	 * @brief Finds groups of assets imported from same source files (like same texture imported several times into different folders).
+	 * Only asset registry import data tags are used, no files are read. Assets are grouped only with assets of same class.
+	 * Files that are already reclaimable in given byte identical groups are left out, so their size is not counted twice.
+	 * @param InAssets TArray<FAssetData>
+	 * @param InGroupsIdentical TArray<FPjcDuplicateGroup> - Groups found by FindFiles
+	 * @param OutGroups TArray<FPjcDuplicateGroup>
+	 */
+	static void FindAssetsSameSource(const TArray<FAssetData>& InAssets, const TArray<FPjcDuplicateGroup>& InGroupsIdentical, TArray<FPjcDuplicateGroup>& OutGroups);
+};
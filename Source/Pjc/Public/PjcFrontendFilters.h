@@ -139,3 +139,26 @@ private:
 	FPjcDelegateFilterChanged DelegateFilterChanged;
 	TSet<FAssetData> Assets;
 };
+
+class FPjcFilterAssetsDuplicate final : public FFrontendFilter
+{
+public:
+	explicit FPjcFilterAssetsDuplicate(TSharedPtr<FFrontendFilterCategory> InCategory);
+	virtual FString GetName() const override;
+	virtual FText GetDisplayName() const override;
+	virtual FText GetToolTipText() const override;
+	virtual FLinearColor GetColor() const override;
+	virtual void ActiveStateChanged(bool bActive) override;
+	virtual bool PassesFilter(const FContentBrowserItem& InItem) const override;
+	// duplicates require reading files, so they are searched only when filter is active
+	void UpdateData();
+	const TSet<FAssetData>& GetAssets() const;
+	int64 GetSizeReclaimable() const;
+
+	FPjcDelegateFilterChanged& OnFilterChanged();
+
+private:
+	FPjcDelegateFilterChanged DelegateFilterChanged;
+	TSet<FAssetData> Assets;
+	int64 SizeReclaimable = 0;
+};
@@ -0,0 +1,118 @@
+﻿// Copyright Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PjcPathScanner.h"
+#include "PjcScanCache.h"
+
+/**
+ * @brief Extracts asset path candidates from content of single file format.
+ * Scanners are called from worker threads, so Scan must not modify scanner state.
+ */
+class IPjcIndirectScanner
+{
+public:
+	virtual ~IPjcIndirectScanner() = default;
+
+	/**
+	 * @brief Returns file extensions (without dot) handled by this scanner
+	 * @return TArray<FString>
+	 */
+	virtual TArray<FString> GetExtensions() const = 0;
+
+	/**
+	 * @brief Appends asset path candidates with their line numbers found in given utf8 file content
+	 * @param Data const uint8*
+	 * @param Size int64
+	 * @param OutCandidates TArray<FPjcScanCandidate>
+	 */
+	virtual void Scan(const uint8* Data, const int64 Size, TArray<FPjcScanCandidate>& OutCandidates) const = 0;
+};
+
+/**
+ * @brief Plain text formats, where asset paths are written as is (source, config, python, csv files)
+ */
+class FPjcIndirectScannerText : public IPjcIndirectScanner
+{
+public:
+	FPjcIndirectScannerText(const TArray<FString>& InExtensions, const TArray<FString>& InPrefixes);
+
+	virtual TArray<FString> GetExtensions() const override;
+	virtual void Scan(const uint8* Data, const int64 Size, TArray<FPjcScanCandidate>& OutCandidates) const override;
+
+protected:
+	TArray<FString> Extensions;
+	FPjcPathScanner PathScanner;
+};
+
+/**
+ * @brief Json based formats (json, uproject, uplugin), where slashes can be escaped like \/Game\/Asset.Asset
+ */
+class FPjcIndirectScannerJson : public FPjcIndirectScannerText
+{
+public:
+	FPjcIndirectScannerJson(const TArray<FString>& InExtensions, const TArray<FString>& InPrefixes);
+
+	virtual void Scan(const uint8* Data, const int64 Size, TArray<FPjcScanCandidate>& OutCandidates) const override;
+};
+
+/**
+ * @brief Extracts asset path candidates from effective config values, merged by GConfig from whole ini hierarchy.
+ * Unlike text scanning, commented out lines and values removed by "-" array operations are ignored.
+ * Only branches that have project or plugin inis in their hierarchy are collected, and only those inis are listed as hierarchy files.
+ */
+class FPjcConfigScanner
+{
+public:
+	explicit FPjcConfigScanner(const TArray<FString>& InPrefixes);
+
+	/**
+	 * @brief Collects candidates of every config branch loaded in GConfig. Branches whose ini files did not change reuse cached results.
+	 * Must be called from game thread.
+	 * @param InCache FPjcScanCache
+	 * @param OutEntries TArray<FPjcScanConfigEntry>
+	 */
+	void Scan(const FPjcScanCache& InCache, TArray<FPjcScanConfigEntry>& OutEntries) const;
+
+private:
+	FPjcPathScanner PathScanner;
+};
+
+/**
+ * @brief Holds indirect scanners for all supported file extensions
+ */
+class FPjcIndirectScanners
+{
+public:
+	explicit FPjcIndirectScanners(const TArray<FString>& InPrefixes);
+
+	/**
+	 * @brief Registers scanner. Scanner registered later overrides previous ones for same extensions.
+	 * @param InScanner TSharedRef<IPjcIndirectScanner>
+	 */
+	void Register(const TSharedRef<IPjcIndirectScanner>& InScanner);
+
+	/**
+	 * @brief Returns scanner for given file or nullptr if file format is not supported
+	 * @param InFilePath FString
+	 * @return const IPjcIndirectScanner*
+	 */
+	const IPjcIndirectScanner* Find(const FString& InFilePath) const;
+
+	/**
+	 * @brief Returns key describing all registered scanners, used to invalidate scan cache when scanners change
+	 * @return FString
+	 */
+	FString GetKey() const;
+
+	/**
+	 * @brief Returns all registered content mount points (like /Game/, /Engine/, /PluginName/)
+	 * @return TArray<FString>
+	 */
+	static TArray<FString> GetMountPrefixes();
+
+private:
+	TArray<FString> Prefixes;
+	TMap<FString, TSharedRef<IPjcIndirectScanner>> ScannersByExt;
+};
@@ -0,0 +1,23 @@
+﻿// Copyright Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @brief Detects broken package files without loading them.
+ * Only package summary and package end tag are read, through async reads with many files in flight.
+ * Results are cached by file size and time, so unchanged packages are not read again.
+ */
+class FPjcPackageValidator
+{
+public:
+	/**
+	 * @brief Validates given package files. Package is invalid if its truncated, has wrong tag,
+	 * was saved by newer or unsupported old engine version or its size does not match sibling .uexp/.ubulk files.
+	 * @param InFiles TArray<FString> - Absolute paths of .uasset and .umap files in Content folder
+	 * @param OutInvalidFiles TArray<FString>
+	 * @param bShowSlowTask bool
+	 */
+	static void Validate(const TArray<FString>& InFiles, TArray<FString>& OutInvalidFiles, const bool bShowSlowTask);
+};
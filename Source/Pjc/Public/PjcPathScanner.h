@@ -0,0 +1,98 @@
+﻿// Copyright Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+struct FPjcPathScanMatch
+{
+	int64 Offset = 0;
+	int32 Len = 0;
+};
+
+/**
+ * @brief Finds asset paths (like /Game/Folder/Asset.Asset) in raw file bytes.
+ * Produces the same matches as \/Game([A-Za-z0-9_.\/]+)\b regex, but for any set of mount point prefixes
+ * and without converting file content to FString.
+ * All prefixes are compiled into single Aho-Corasick automaton, so file is scanned once in linear time regardless of prefixes count.
+ */
+class FPjcPathScanner
+{
+public:
+	explicit FPjcPathScanner(const TArray<FString>& InPrefixes);
+
+	/**
+	 * @brief Appends all path matches found in given buffer
+	 * @param Data const uint8*
+	 * @param Size int64
+	 * @param OutMatches TArray<FPjcPathScanMatch>
+	 */
+	void Scan(const uint8* Data, const int64 Size, TArray<FPjcPathScanMatch>& OutMatches) const;
+
+	/**
+	 * @brief Returns pointer to first occurrence of given byte in [Begin, End) range or End if not found. Uses SSE2/AVX2 when available.
+	 * @param Begin const uint8*
+	 * @param End const uint8*
+	 * @param Byte uint8
+	 * @return const uint8*
+	 */
+	static const uint8* FindByte(const uint8* Begin, const uint8* End, const uint8 Byte);
+
+	/**
+	 * @brief Fills offsets of every line start in given buffer. First line always starts at 0.
+	 * @param Data const uint8*
+	 * @param Size int64
+	 * @param OutLineStarts TArray<int64>
+	 */
+	static void GetLineStarts(const uint8* Data, const int64 Size, TArray<int64>& OutLineStarts);
+
+	/**
+	 * @brief Checks if buffer starts with UTF-16 byte order mark. Such buffers must be converted to UTF-8 before scanning.
+	 * @param Data const uint8*
+	 * @param Size int64
+	 * @return bool
+	 */
+	static bool IsUtf16(const uint8* Data, const int64 Size);
+
+	static bool IsPathChar(const uint8 Char);
+	static bool IsWordChar(const uint8 Char);
+
+private:
+	// automaton has transition for every byte in every state, state 0 is root
+	TArray<int32> Transitions;
+	// length of longest prefix that ends in state, 0 if none
+	TArray<int32> MatchLens;
+};
+
+/**
+ * @brief Read only utf8 view of file content. File is memory mapped when platform supports it, otherwise loaded into memory.
+ * Utf16 files are converted to utf8, so scanner always works on same encoding.
+ */
+class FPjcScanFile
+{
+public:
+	FPjcScanFile() = default;
+	~FPjcScanFile();
+
+	FPjcScanFile(const FPjcScanFile&) = delete;
+	FPjcScanFile& operator=(const FPjcScanFile&) = delete;
+
+	/**
+	 * @brief Opens given file. Returns false if file cant be read or is empty.
+	 * @param InFilePath FString
+	 * @return bool
+	 */
+	bool Open(const FString& InFilePath);
+	void Close();
+
+	const uint8* GetData() const;
+	int64 GetSize() const;
+
+private:
+	IMappedFileHandle* MappedHandle = nullptr;
+	IMappedFileRegion* MappedRegion = nullptr;
+	TArray<uint8> Buffer;
+};
@@ -0,0 +1,80 @@
+﻿// Copyright Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/StringBuilder.h"
+
+/**
+ * @brief Path converters that work on string views and write into caller provided string builders.
+ * Project content mount point (/Game and absolute Content folder path) is computed once,
+ * so with stack builders (TStringBuilder<256>) conversions do not allocate at all.
+ * All functions return false and leave empty builder if given path can not be converted.
+ */
+class FPjcPaths
+{
+public:
+	/**
+	 * @brief Normalizes given absolute or /Game path. Slashes are unified, duplicates, "." and ".." segments and trailing slash removed.
+	 * @param InPath FStringView
+	 * @param OutPath FStringBuilderBase
+	 * @return bool
+	 */
+	static bool Normalize(FStringView InPath, FStringBuilderBase& OutPath);
+
+	/**
+	 * @brief Converts given path to absolute path inside Content folder
+	 * @param InPath FStringView
+	 * @param OutPath FStringBuilderBase
+	 * @return bool
+	 */
+	static bool ToAbsolute(FStringView InPath, FStringBuilderBase& OutPath);
+
+	/**
+	 * @brief Converts given path to path relative to Content folder (like /Game/Folder)
+	 * @param InPath FStringView
+	 * @param OutPath FStringBuilderBase
+	 * @return bool
+	 */
+	static bool ToRelative(FStringView InPath, FStringBuilderBase& OutPath);
+
+	/**
+	 * @brief Converts absolute package file path (like Content/Folder/Asset.uasset) to object path (like /Game/Folder/Asset.Asset), without checking file system
+	 * @param InFilePath FStringView
+	 * @param OutObjectPath FStringBuilderBase
+	 * @return bool
+	 */
+	static bool FileToObjectPath(FStringView InFilePath, FStringBuilderBase& OutObjectPath);
+
+	/**
+	 * @brief Converts export text path (like Class'/Game/Folder/Asset.Asset_C') to object path
+	 * @param InPath FStringView
+	 * @param OutObjectPath FStringBuilderBase
+	 * @return bool
+	 */
+	static bool ExportTextToObjectPath(FStringView InPath, FStringBuilderBase& OutObjectPath);
+
+	/**
+	 * @brief Converts export text path to object path, accepting any of given content mount roots (like /Game/, /PluginName/)
+	 * @param InPath FStringView
+	 * @param InRoots TArray<FString>
+	 * @param OutObjectPath FStringBuilderBase
+	 * @return bool
+	 */
+	static bool ExportTextToObjectPath(FStringView InPath, const TArray<FString>& InRoots, FStringBuilderBase& OutObjectPath);
+
+	/**
+	 * @brief Returns absolute Content folder path without trailing slash
+	 * @return FStringView
+	 */
+	static FStringView GetContentDir();
+
+	/**
+	 * @brief Returns project content mount point root (/Game)
+	 * @return FStringView
+	 */
+	static FStringView GetContentRoot();
+
+	static bool IsUnderContentDir(FStringView InPath);
+	static bool IsUnderContentRoot(FStringView InPath);
+};
@@ -0,0 +1,52 @@
+﻿// Copyright Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @brief Reversible alternative to deletion. Files are renamed into Saved/ProjectCleaner/Quarantine/<timestamp>/ keeping their project relative paths,
+ * which is single rename per file on same file system and requires no asset loading.
+ * Every quarantine has manifest with all its files, so it can be restored or purged later as whole.
+ */
+class FPjcQuarantine
+{
+public:
+	/**
+	 * @brief Moves given files into new quarantine. Manifest is written before any file is moved, so interrupted quarantine still can be restored.
+	 * @param InFiles TArray<FString> - Absolute paths of files inside project folder
+	 * @param OutQuarantineId FString - Name of created quarantine folder
+	 * @param bShowSlowTask bool
+	 * @return int32 - Number of moved files
+	 */
+	static int32 Move(const TArray<FString>& InFiles, FString& OutQuarantineId, const bool bShowSlowTask);
+
+	/**
+	 * @brief Moves all files of given quarantine back to their original locations. Files, which original location is occupied again, are kept in quarantine.
+	 * @param InQuarantineId FString
+	 * @param OutFilesRestored TArray<FString> - Absolute paths of restored files
+	 * @param bShowSlowTask bool
+	 * @return bool - true if every file was restored and quarantine folder was removed
+	 */
+	static bool Restore(const FString& InQuarantineId, TArray<FString>& OutFilesRestored, const bool bShowSlowTask);
+
+	/**
+	 * @brief Permanently deletes given quarantine with all its files
+	 * @param InQuarantineId FString
+	 * @return bool
+	 */
+	static bool Purge(const FString& InQuarantineId);
+
+	/**
+	 * @brief Returns ids of all quarantines, oldest first
+	 * @param OutQuarantineIds TArray<FString>
+	 */
+	static void GetQuarantineIds(TArray<FString>& OutQuarantineIds);
+
+	static FString GetQuarantineDir();
+	static FString GetQuarantineDir(const FString& InQuarantineId);
+
+private:
+	static bool ManifestSave(const FString& InQuarantineId, const TArray<FString>& InFiles);
+	static bool ManifestLoad(const FString& InQuarantineId, TArray<FString>& OutFiles);
+};
@@ -0,0 +1,155 @@
+﻿// Copyright Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PjcTypes.h"
+
+struct FPjcScanCandidate
+{
+	FString Path;
+	int32 FileNum = 0;
+
+	friend FArchive& operator<<(FArchive& Ar, FPjcScanCandidate& Candidate)
+	{
+		Ar << Candidate.Path;
+		Ar << Candidate.FileNum;
+		return Ar;
+	}
+};
+
+struct FPjcScanCacheEntry
+{
+	FString FilePath;
+	int64 FileSize = 0;
+	FDateTime FileTime;
+	uint64 FileHash = 0;
+	TArray<FPjcScanCandidate> Candidates;
+
+	friend FArchive& operator<<(FArchive& Ar, FPjcScanCacheEntry& Entry)
+	{
+		Ar << Entry.FilePath;
+		Ar << Entry.FileSize;
+		Ar << Entry.FileTime;
+		Ar << Entry.FileHash;
+		Ar << Entry.Candidates;
+		return Ar;
+	}
+};
+
+struct FPjcScanConfigEntry
+{
+	FString BranchPath;
+	uint64 HierarchyHash = 0;
+	TArray<FString> HierarchyFiles;
+	TArray<FString> Candidates;
+
+	friend FArchive& operator<<(FArchive& Ar, FPjcScanConfigEntry& Entry)
+	{
+		Ar << Entry.BranchPath;
+		Ar << Entry.HierarchyHash;
+		Ar << Entry.HierarchyFiles;
+		Ar << Entry.Candidates;
+		return Ar;
+	}
+};
+
+/**
+ * @brief Persistent per file results of indirect assets scan, stored under Saved/ProjectCleaner.
+ * Entries are matched by file stat first and by content hash second, so only changed files are rescanned.
+ */
+class FPjcScanCache
+{
+public:
+	/**
+	 * @brief Loads cache from disk. Cache written by different version or with different scanner key is discarded.
+	 * @param InScannerKey FString - Describes scanner settings, that affect results (like searched prefixes)
+	 */
+	void Load(const FString& InScannerKey);
+
+	/**
+	 * @brief Replaces all entries with given ones and writes cache to disk
+	 * @param InEntries TArray<FPjcScanCacheEntry>
+	 * @param InConfigEntries TArray<FPjcScanConfigEntry>
+	 */
+	void Save(TArray<FPjcScanCacheEntry>&& InEntries, TArray<FPjcScanConfigEntry>&& InConfigEntries);
+
+	/**
+	 * @brief Returns cached entry for given file or nullptr. Safe to call from multiple threads after Load.
+	 * @param InFilePath FString
+	 * @return const FPjcScanCacheEntry*
+	 */
+	const FPjcScanCacheEntry* Find(const FString& InFilePath) const;
+
+	/**
+	 * @brief Returns cached effective config candidates for given config branch or nullptr
+	 * @param InBranchPath FString
+	 * @return const FPjcScanConfigEntry*
+	 */
+	const FPjcScanConfigEntry* FindConfig(const FString& InBranchPath) const;
+
+	static FString GetCacheFilePath();
+	static uint64 GetHash(const uint8* Data, const int64 Size);
+
+private:
+	FString ScannerKey;
+	TMap<FString, FPjcScanCacheEntry> Entries;
+	TMap<FString, FPjcScanConfigEntry> ConfigEntries;
+};
+
+struct FPjcIndirectIndexRef
+{
+	int32 FileId = 0;
+	int32 FileNum = 0;
+
+	friend FArchive& operator<<(FArchive& Ar, FPjcIndirectIndexRef& Ref)
+	{
+		Ar << Ref.FileId;
+		Ar << Ref.FileNum;
+		return Ar;
+	}
+};
+
+/**
+ * @brief Persistent reverse index from asset to source and config file lines that reference it.
+ * Rebuilt after every indirect assets scan and stored next to scan cache, so lookups do not require rescanning.
+ */
+class FPjcIndirectIndex
+{
+public:
+	/**
+	 * @brief Rebuilds index from given indirect assets infos
+	 * @param InAssetsIndirectInfos TArray<FPjcAssetIndirectInfo>
+	 */
+	void Build(const TArray<FPjcAssetIndirectInfo>& InAssetsIndirectInfos);
+
+	/**
+	 * @brief Loads index from disk. Returns false if index does not exist yet or was written by different version.
+	 * @return bool
+	 */
+	bool Load();
+	void Save() const;
+
+	/**
+	 * @brief Returns true if index was built or successfully loaded from disk
+	 * @return bool
+	 */
+	bool IsValid() const;
+
+	/**
+	 * @brief Returns all file lines that reference given asset
+	 * @param InObjectPath FName
+	 * @param OutFileInfos TArray<FPjcFileInfo>
+	 */
+	void Find(const FName& InObjectPath, TArray<FPjcFileInfo>& OutFileInfos) const;
+
+	const TArray<FString>& GetFiles() const;
+	const TMap<FName, TArray<FPjcIndirectIndexRef>>& GetRefs() const;
+
+	static FString GetIndexFilePath();
+
+private:
+	TArray<FString> Files;
+	TMap<FName, TArray<FPjcIndirectIndexRef>> Refs;
+	bool bValid = false;
+};
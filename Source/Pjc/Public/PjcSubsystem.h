@@ -11,6 +11,9 @@
 #include "PjcTypes.h"
 #include "PjcSubsystem.generated.h"
 
+class FPjcDeletionPlan;
+class FPjcIndirectIndex;
+
 UCLASS(Config=EditorPerProjectUserSettings, DisplayName="ProjectCleanerSubsystem")
 class UPjcSubsystem final : public UEditorSubsystem
 {
@@ -64,6 +67,23 @@ public:
 	UFUNCTION(BlueprintCallable, Category="ProjectCleanerSubsystem|Lib_Asset")
 	static void GetAssetsIndirect(TArray<FAssetData>& Assets, TArray<FPjcAssetIndirectInfo>& AssetsIndirectInfos, const bool bShowSlowTask = true);
 
+	/**
+	 * @brief Returns indirectly used assets from index saved by last GetAssetsIndirect call, without rescanning any files.
+	 * @param Assets TArray<FAssetData> - Assets
+	 * @param AssetsIndirectInfos TArray<FPjcAssetIndirectInfo> - Assets and their usage information
+	 * @return bool - False if project was never scanned and index does not exist
+	 */
+	UFUNCTION(BlueprintCallable, Category="ProjectCleanerSubsystem|Lib_Asset")
+	static bool GetAssetsIndirectFromIndex(TArray<FAssetData>& Assets, TArray<FPjcAssetIndirectInfo>& AssetsIndirectInfos);
+
+	/**
+	 * @brief Returns source and config file lines that reference given asset, using index saved by last indirect assets scan.
+	 * @param InAsset FAssetData
+	 * @param FileInfos TArray<FPjcFileInfo>
+	 */
+	UFUNCTION(BlueprintCallable, Category="ProjectCleanerSubsystem|Lib_Asset")
+	static void GetAssetIndirectReferences(const FAssetData& InAsset, TArray<FPjcFileInfo>& FileInfos);
+
 	/**
 	 * @brief Returns assets that have circular dependencies
 	 * @param Assets TArray<FAssetData>
@@ -96,6 +116,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category="ProjectCleanerSubsystem|Lib_Asset")
 	static void GetAssetsExtReferenced(TArray<FAssetData>& Assets, const bool bShowSlowTask = true);
 
+	/**
+	 * @brief Returns all assets, whose package files are byte identical to other package or that were imported from same source files as other asset
+	 * @param Assets TArray<FAssetData>
+	 * @param bShowSlowTask bool
+	 */
+	UFUNCTION(BlueprintCallable, Category="ProjectCleanerSubsystem|Lib_Asset")
+	static void GetAssetsDuplicate(TArray<FAssetData>& Assets, const bool bShowSlowTask = true);
+
 	/**
 	 * @brief Returns all primary assets class names
 	 * @param ClassNames TSet<FName>
@@ -161,13 +189,31 @@ public:
 	static void GetFilesExternalExcluded(TArray<FString>& Files, const bool bShowSlowTask = true);
 
 	/**
-	 * @brief Returns all corrupted asset files in project
+	 * @brief Returns all corrupted asset files in project. Those are asset files that AssetRegistry failed to register.
 	 * @param Files
 	 * @param bShowSlowTask bool
 	 */
 	UFUNCTION(BlueprintCallable, Category="ProjectCleanerSubsystem|Lib_Path")
 	static void GetFilesCorrupted(TArray<FString>& Files, const bool bShowSlowTask = true);
 
+	/**
+	 * @brief Returns asset files that are registered by AssetRegistry, but whose package header or tail looks broken.
+	 * Only header and tail are read, so those are reported for review and never deleted by plugin.
+	 * @param Files
+	 * @param bShowSlowTask bool
+	 */
+	UFUNCTION(BlueprintCallable, Category="ProjectCleanerSubsystem|Lib_Path")
+	static void GetFilesSuspect(TArray<FString>& Files, const bool bShowSlowTask = true);
+
+	/**
+	 * @brief Returns groups of duplicated files in Content folder. Byte identical files and assets imported from same source files are grouped.
+	 * Groups are sorted by reclaimable size, biggest first.
+	 * @param Groups TArray<FPjcDuplicateGroup>
+	 * @param bShowSlowTask bool
+	 */
+	UFUNCTION(BlueprintCallable, Category="ProjectCleanerSubsystem|Lib_Path")
+	static void GetDuplicateGroups(TArray<FPjcDuplicateGroup>& Groups, const bool bShowSlowTask = true);
+
 	/**
 	 * @brief Returns all subfolders in given path
 	 * @param InSearchPath FString
@@ -192,6 +238,43 @@ public:
 	UFUNCTION(BlueprintCallable, Category="ProjectCleanerSubsystem|Lib_Asset")
 	static void DeleteAssetsUnused(const bool bShowSlowTask = true, const bool bShowEditorNotification = false);
 
+	/**
+	 * @brief Continues deletion of unused assets, that was interrupted by crash or error, from last finished bucket.
+	 * Remaining planned assets are validated against asset registry first, deletion is not resumed if any of them got referenced by asset outside of plan.
+	 * @param bShowSlowTask bool
+	 * @param bShowEditorNotification bool
+	 * @return bool
+	 */
+	UFUNCTION(BlueprintCallable, Category="ProjectCleanerSubsystem|Lib_Asset")
+	static bool DeleteAssetsUnusedResume(const bool bShowSlowTask = true, const bool bShowEditorNotification = false);
+
+	/**
+	 * @brief Checks if there is interrupted deletion, that can be resumed
+	 * @return bool
+	 */
+	UFUNCTION(BlueprintCallable, Category="ProjectCleanerSubsystem|Lib_Asset")
+	static bool DeletionCanResume();
+
+	/**
+	 * @brief Builds deletion plan of all unused assets without deleting or loading anything and saves it to json file.
+	 * Plan contains deletion order, every file that would be deleted with its size, affected folders and folders that would become empty.
+	 * @param PlanFilePath FString - Absolute or project relative path. If empty Saved/ProjectCleaner/DeletionPlan.json is used.
+	 * @param bShowSlowTask bool
+	 * @return bool
+	 */
+	UFUNCTION(BlueprintCallable, Category="ProjectCleanerSubsystem|Lib_Asset")
+	static bool DeleteAssetsUnusedDryRun(const FString& PlanFilePath, const bool bShowSlowTask = true);
+
+	/**
+	 * @brief Deletes assets by plan saved with DeleteAssetsUnusedDryRun. Plan is executed only if unused assets and their files did not change since it was made.
+	 * @param PlanFilePath FString - Absolute or project relative path. If empty Saved/ProjectCleaner/DeletionPlan.json is used.
+	 * @param bShowSlowTask bool
+	 * @param bShowEditorNotification bool
+	 * @return bool
+	 */
+	UFUNCTION(BlueprintCallable, Category="ProjectCleanerSubsystem|Lib_Asset")
+	static bool DeleteAssetsUnusedByPlan(const FString& PlanFilePath, const bool bShowSlowTask = true, const bool bShowEditorNotification = false);
+
 	/**
 	 * @brief Delete all empty folders in project
 	 * @param bShowSlowTask bool
@@ -216,6 +299,41 @@ public:
 	UFUNCTION(BlueprintCallable, Category="ProjectCleanerSubsystem|Lib_Path")
 	static void DeleteFilesCorrupted(const bool bShowSlowTask = true, const bool bShowEditorNotification = false);
 
+	/**
+	 * @brief Moves all unused assets and external files into new quarantine folder under Saved/ProjectCleaner/Quarantine instead of deleting them.
+	 * Files are only renamed, nothing is loaded. Unused packages that are loaded in memory are kept in place.
+	 * @param bShowSlowTask bool
+	 * @param bShowEditorNotification bool
+	 * @return FString - Id of created quarantine or empty string if nothing was moved
+	 */
+	UFUNCTION(BlueprintCallable, Category="ProjectCleanerSubsystem|Lib_Quarantine")
+	static FString QuarantineUnused(const bool bShowSlowTask = true, const bool bShowEditorNotification = false);
+
+	/**
+	 * @brief Moves all files of given quarantine back to their original locations
+	 * @param QuarantineId FString - If empty latest quarantine is restored
+	 * @param bShowSlowTask bool
+	 * @param bShowEditorNotification bool
+	 * @return bool
+	 */
+	UFUNCTION(BlueprintCallable, Category="ProjectCleanerSubsystem|Lib_Quarantine")
+	static bool QuarantineRestore(const FString& QuarantineId, const bool bShowSlowTask = true, const bool bShowEditorNotification = false);
+
+	/**
+	 * @brief Permanently deletes given quarantine
+	 * @param QuarantineId FString - If empty all quarantines are deleted
+	 * @return bool
+	 */
+	UFUNCTION(BlueprintCallable, Category="ProjectCleanerSubsystem|Lib_Quarantine")
+	static bool QuarantinePurge(const FString& QuarantineId);
+
+	/**
+	 * @brief Returns ids of all quarantines, oldest first
+	 * @param QuarantineIds TArray<FString>
+	 */
+	UFUNCTION(BlueprintCallable, Category="ProjectCleanerSubsystem|Lib_Quarantine")
+	static void GetQuarantineIds(TArray<FString>& QuarantineIds);
+
 	/**
 	 * @brief Returns all redirectors in project
 	 * @param Redirectors TArray<FAssetData>
@@ -301,6 +419,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category="ProjectCleanerSubsystem|Lib_Path")
 	static FString PathConvertToObjectPath(const FString& InPath);
 
+	/**
+	 * @brief Convert given export text path (like /Game/Folder/Asset.Asset_C) to object path, without checking file system
+	 * @param InPath FString
+	 * @return FString - Empty if given path is not valid asset object path
+	 */
+	UFUNCTION(BlueprintCallable, Category="ProjectCleanerSubsystem|Lib_Path")
+	static FString PathConvertExportTextToObjectPath(const FString& InPath);
+
 	/**
 	 * @brief Returns given asset size on disk in bytes
 	 * @param InAsset FAssetData
@@ -341,6 +467,36 @@ public:
 	UFUNCTION(BlueprintCallable, Category="ProjectCleanerSubsystem|Lib_Asset")
 	static FName GetAssetExactClassName(const FAssetData& InAsset);
 
+	/**
+	 * @brief Returns empty state of every Content folder in single bottom up pass over content table.
+	 * Folder is empty if it has no files and no in memory assets and all its subfolders are empty.
+	 * @param OutFlags TArray<bool> - Indexed same as FPjcContentIndex folders
+	 */
+	static void GetFoldersEmptyFlags(TArray<bool>& OutFlags);
+
+	/**
+	 * @brief Returns on disk usage of every Content folder including all its subfolders, split into used and unused package bytes,
+	 * package sidecar (.uexp, .ubulk, .uptnl) bytes and external file bytes. Computed in single pass over content table files and single bottom up pass over folders.
+	 * @param InAssetsUnused TArray<FAssetData> - Packages of these assets are counted as unused, all other packages as used
+	 * @param OutUsage TArray<FPjcFolderDiskUsage> - Indexed same as content table folders
+	 */
+	static void GetFoldersDiskUsage(const TArray<FAssetData>& InAssetsUnused, TArray<FPjcFolderDiskUsage>& OutUsage);
+
+	/**
+	 * @brief Returns assets, whose package files are in given duplicate groups
+	 * @param Groups TArray<FPjcDuplicateGroup> - Groups found by GetDuplicateGroups
+	 * @param Assets TArray<FAssetData>
+	 */
+	static void GetAssetsByDuplicateGroups(const TArray<FPjcDuplicateGroup>& Groups, TArray<FAssetData>& Assets);
+
+	/**
+	 * @brief Deletes given files in parallel on limited number of workers and notifies views once for all of them
+	 * @param InFiles TArray<FString>
+	 * @param InTitle FString - Slow task title
+	 * @param bShowSlowTask bool
+	 * @return int32 - Number of actually deleted files
+	 */
+	static int32 FilesDelete(const TArray<FString>& InFiles, const FString& InTitle, const bool bShowSlowTask);
 	static bool FolderIsEmpty(const FString& InPath);
 	static bool FolderIsExcluded(const FString& InPath);
 	static bool FolderIsEngineGenerated(const FString& InPath);
@@ -356,6 +512,7 @@ public:
 	static void OpenReferenceViewer(const TArray<FAssetData>& InAssets);
 	static void OpenAssetAuditViewer(const TArray<FAssetData>& InAssets);
 	static void TryOpenFile(const FString& InPath);
+	static void TryOpenFileAtLine(const FString& InPath, const int32 InLine);
 
 	static FAssetToolsModule& GetModuleAssetTools();
 	static FAssetRegistryModule& GetModuleAssetRegistry();
@@ -365,6 +522,14 @@ public:
 	UPROPERTY(Config)
 	bool bShowFilesExternal = true;
 
+	// unused packages, that are not loaded and have no referencers, are deleted directly from disk without loading them
+	UPROPERTY(Config)
+	bool bDeleteAssetsLoadFree = true;
+
+	// memory budget in megabytes for deleting unused assets, bucket size is adjusted to stay under it. 0 means 60% of physical memory
+	UPROPERTY(Config)
+	int32 DeleteMemoryBudgetMb = 0;
+
 	UPROPERTY(Config)
 	bool bShowFoldersEmpty = true;
 
@@ -380,7 +545,69 @@ public:
 	bool bFirstScan = true;
 
 private:
-	static void BucketFill(TArray<FAssetData>& AssetsUnused, TArray<FAssetData>& Bucket, const int32 BucketSize);
-	static bool BucketPrepare(const TArray<FAssetData>& Bucket, TArray<UObject*>& LoadedAssets);
+	FDelegateHandle DirectoryWatcherHandle;
+
+	static void GetFilesExcludedBySettings(const UPjcFileExcludeSettings* InSettings, TSet<FString>& OutFiles);
+
+	/**
+	 * @brief Returns indirect assets index kept in memory. Index is loaded from disk on first call and replaced by every indirect scan.
+	 * @return const FPjcIndirectIndex&
+	 */
+	static const FPjcIndirectIndex& GetIndirectIndex();
+
+	static FString GetDeletionPlanFilePath();
+	static bool DeletionPrepare();
+
+	/**
+	 * @brief Checks that deletion can start, without changing any assets. AssetRegistry must be idle and all asset editors closed.
+	 * @return bool
+	 */
+	static bool DeletionCanStart();
+
+	/**
+	 * @brief Returns memory budget for deletion. Uses DeleteMemoryBudgetMb if set, otherwise part of physical memory.
+	 * @return uint64 - Bytes
+	 */
+	static uint64 GetDeletionMemoryBudget();
+
+	/**
+	 * @brief Returns size of next deletion bucket. Bucket is halved while memory is over budget, otherwise it is sized to fit remaining memory
+	 * by memory cost of previous bucket, but grows at most twice per bucket.
+	 * @param InBucketSize int32 - Size of previous bucket
+	 * @param InNumAssetsLoaded int32 - Number of assets that were loaded in previous bucket
+	 * @param InMemoryGrowth uint64 - Memory taken by loading previous bucket
+	 * @param InMemoryUsed uint64 - Memory used now
+	 * @param InMemoryBudget uint64
+	 * @return int32
+	 */
+	static int32 GetDeletionBucketSizeNext(const int32 InBucketSize, const int32 InNumAssetsLoaded, const uint64 InMemoryGrowth, const uint64 InMemoryUsed, const uint64 InMemoryBudget);
+	static void DeletionExecute(const FPjcDeletionPlan& InDeletionPlan, const bool bShowSlowTask, const bool bShowEditorNotification);
+
+	static bool BucketPrepare(const TArrayView<const FAssetData>& Bucket, TArray<UObject*>& LoadedAssets);
 	static int32 BucketDelete(const TArray<UObject*>& LoadedAssets);
+
+	/**
+	 * @brief Appends package file and its existing sidecar files (.uexp, .ubulk etc.) of given package. Package file is always appended first.
+	 * @param InPackageName FName
+	 * @param OutFiles TArray<FString>
+	 * @return bool - false if package does not exist on disk
+	 */
+	static bool PackageGetFiles(const FName& InPackageName, TArray<FString>& OutFiles);
+
+	/**
+	 * @brief Splits bucket into assets, which packages are not in memory and have no referencers left, and assets that must be loaded before deletion
+	 * @param Bucket TArrayView<const FAssetData>
+	 * @param PackagesDeletedLoadFree TSet<FName> - Packages deleted without loading so far, asset registry may still report them as referencers
+	 * @param AssetsLoadFree TArray<FAssetData>
+	 * @param AssetsLoad TArray<FAssetData>
+	 */
+	static void BucketSplit(const TArrayView<const FAssetData>& Bucket, const TSet<FName>& PackagesDeletedLoadFree, TArray<FAssetData>& AssetsLoadFree, TArray<FAssetData>& AssetsLoad);
+
+	/**
+	 * @brief Deletes package files of given assets directly, without loading them. Files under source control are marked for delete in single batch.
+	 * @param Assets TArray<FAssetData>
+	 * @param PackagesDeletedLoadFree TSet<FName>
+	 * @return int32 - Number of deleted assets
+	 */
+	static int32 BucketDeleteLoadFree(const TArray<FAssetData>& Assets, TSet<FName>& PackagesDeletedLoadFree);
 };
@@ -83,6 +83,33 @@ struct FPjcCorruptedAssetItem
 	FString FilePath;
 };
 
+struct FPjcAssetIndirectMatch
+{
+	FName ObjectPath;
+	int32 FileNum = 0;
+};
+
+struct FPjcFolderDiskUsage
+{
+	int64 SizeUsed = 0;
+	int64 SizeUnused = 0;
+	int64 SizeExternal = 0;
+	int64 SizeSidecar = 0;
+
+	int64 GetSizeTotal() const
+	{
+		return SizeUsed + SizeUnused + SizeExternal + SizeSidecar;
+	}
+
+	void Add(const FPjcFolderDiskUsage& Other)
+	{
+		SizeUsed += Other.SizeUsed;
+		SizeUnused += Other.SizeUnused;
+		SizeExternal += Other.SizeExternal;
+		SizeSidecar += Other.SizeSidecar;
+	}
+};
+
 struct FPjcTreeItem
 {
 	FString FolderPath;
@@ -99,6 +126,7 @@ struct FPjcTreeItem
 	float SizeAssetsUnused = 0;
 	float PercentageUnused = 0;
 	float PercentageUnusedNormalized = 0;
+	FPjcFolderDiskUsage DiskUsage;
 
 	TSharedPtr<FPjcTreeItem> Parent;
 	TArray<TSharedPtr<FPjcTreeItem>> SubItems;
@@ -159,4 +187,32 @@ struct FPjcAssetIndirectInfo
 	{
 		return !(Asset == Other.Asset && FilePath.Equals(Other.FilePath) && FileNum == Other.FileNum);
 	}
+
+	friend uint32 GetTypeHash(const FPjcAssetIndirectInfo& Info)
+	{
+		return HashCombine(HashCombine(GetTypeHash(Info.Asset.ObjectPath), GetTypeHash(Info.FilePath)), GetTypeHash(Info.FileNum));
+	}
+};
+
+USTRUCT(BlueprintType)
+struct FPjcDuplicateGroup
+{
+	GENERATED_BODY()
+
+	// content hash of files or asset class with combined hashes of import source files for assets imported from same source
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category="DuplicateGroup")
+	FString Hash;
+
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category="DuplicateGroup")
+	TArray<FString> Files;
+
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category="DuplicateGroup")
+	int64 SizeTotal = 0;
+
+	// size of all files except biggest one, that is freed if only one file of group is kept
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category="DuplicateGroup")
+	int64 SizeReclaimable = 0;
+
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category="DuplicateGroup")
+	bool bSameSource = false;
 };
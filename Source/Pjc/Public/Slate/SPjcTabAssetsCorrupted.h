@@ -14,22 +14,25 @@ public:
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs);
+	virtual ~SPjcTabAssetsCorrupted() override;
 
 protected:
-	void ListUpdateData();
+	void ListUpdateData(const bool bShowSlowTask);
 	void ListUpdateView();
 	void OnListSort(EColumnSortPriority::Type SortPriority, const FName& ColumnName, EColumnSortMode::Type InSortMode);
 	void OnSearchTextChanged(const FText&);
 	void OnSearchTextCommitted(const FText&, ETextCommit::Type);
-	TSharedRef<SHeaderRow> GetListHeaderRow();
+	TSharedRef<SHeaderRow> GetListHeaderRow(const bool bSortable);
 	TSharedRef<ITableRow> OnListGenerateRow(TSharedPtr<FPjcCorruptedAssetItem> Item, const TSharedRef<STableViewBase>& OwnerTable) const;
 	TSharedPtr<SWidget> OnContextMenuOpening() const;
 	TSharedRef<SWidget> CreateToolbar() const;
 	FText GetTxtSummary() const;
 	int32 GetWidgetIndex() const;
+	EVisibility GetSuspectVisibility() const;
 
 private:
 	void OnRefresh();
+	void OnContentChanged();
 	void OnDelete();
 	void OnClearSelection() const;
 	bool AnyAssetSelected() const;
@@ -38,9 +41,13 @@ private:
 	int32 NumFilesTotal = 0;
 	int64 SizeFilesTotal = 0;
 	TSharedPtr<FUICommandList> Cmds;
+	FDelegateHandle DelegateHandleContentChanged;
 	TArray<TSharedPtr<FPjcCorruptedAssetItem>> ItemsAll;
 	TArray<TSharedPtr<FPjcCorruptedAssetItem>> ItemsFiltered;
 	TSharedPtr<SListView<TSharedPtr<FPjcCorruptedAssetItem>>> ListView;
+	TArray<TSharedPtr<FPjcCorruptedAssetItem>> ItemsSuspectAll;
+	TArray<TSharedPtr<FPjcCorruptedAssetItem>> ItemsSuspectFiltered;
+	TSharedPtr<SListView<TSharedPtr<FPjcCorruptedAssetItem>>> ListViewSuspect;
 
 	EColumnSortMode::Type ColumnSortModeFilePath = EColumnSortMode::None;
 	EColumnSortMode::Type ColumnSortModeFileName = EColumnSortMode::None;
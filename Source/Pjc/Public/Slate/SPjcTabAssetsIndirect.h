@@ -21,7 +21,7 @@ protected:
 	TSharedRef<SHeaderRow> GetHeaderRow();
 	TSharedRef<ITableRow> OnGenerateRow(TSharedPtr<FPjcAssetIndirectInfo> Item, const TSharedRef<STableViewBase>& OwnerTable) const;
 	void OnMouseDoubleClicked(TSharedPtr<FPjcAssetIndirectInfo> Item);
-	void ListUpdateData();
+	void ListUpdateData(const bool bRescan);
 	void ListUpdateView();
 	void OnListSort(EColumnSortPriority::Type SortPriority, const FName& ColumnName, EColumnSortMode::Type InSortMode);
 	void OnSearchTextChanged(const FText& InText);
@@ -16,6 +16,7 @@ class FPjcFilterAssetsIndirect;
 class FPjcFilterAssetsPrimary;
 class FPjcFilterAssetsUsed;
 class FPjcFilterAssetsExcluded;
+class FPjcFilterAssetsDuplicate;
 
 class SPjcTabAssetsUnused final : public SCompoundWidget
 {
@@ -24,6 +25,7 @@ public:
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs);
+	virtual ~SPjcTabAssetsUnused() override;
 
 private:
 	TSharedRef<SWidget> CreateToolbarMain() const;
@@ -31,6 +33,9 @@ private:
 	TSharedRef<SWidget> CreateToolbarContentBrowser() const;
 	void OnProjectScan();
 	void OnProjectClean();
+	void OnProjectQuarantine();
+	void OnDeletionResume();
+	void OnQuarantineRestore();
 	void OnResetExcludeSettings();
 	void OnDeleteEmptyFolders();
 	void OnPathReveal() const;
@@ -49,6 +54,8 @@ private:
 	void OnAssetsDelete();
 	void ScanProject();
 	void UpdateStats();
+	void UpdateFoldersData();
+	void OnContentChanged();
 	void UpdateTreeView();
 	void UpdateContentBrowser();
 	void OnTreeGetChildren(TSharedPtr<FPjcTreeItem> Item, TArray<TSharedPtr<FPjcTreeItem>>& OutChildren);
@@ -64,6 +71,7 @@ private:
 	bool TreeItemContainsSearchText(const TSharedPtr<FPjcTreeItem>& Item) const;
 	bool TreeHasSelection() const;
 	bool CanCleanProject() const;
+	bool CanResumeDeletion() const;
 	bool CanDeleteEmptyFolders() const;
 	bool AnyFilterActive() const;
 	bool AnyAssetSelected() const;
@@ -87,6 +95,8 @@ private:
 	void OnFilterEditorChanged(const bool bActive);
 	void OnFilterExcludedChanged(const bool bActive);
 	void OnFilterExtReferencedChanged(const bool bActive);
+	void OnFilterDuplicateChanged(const bool bActive);
+	void UpdateAssetsDuplicate();
 	void OnAssetDblClicked(const FAssetData& AssetData);
 	void OnShowFoldersEmpty();
 	void OnShowFoldersExcluded();
@@ -107,6 +117,7 @@ private:
 
 	UPjcSubsystem* SubsystemPtr = nullptr;
 	TSharedPtr<FUICommandList> Cmds;
+	FDelegateHandle DelegateHandleContentChanged;
 	FText TreeSearchText;
 	const FMargin HeaderMargin{5.0f};
 	TSet<FName> SelectedPaths;
@@ -128,6 +139,7 @@ private:
 	EColumnSortMode::Type ColumnAssetsUnusedSortMode = EColumnSortMode::None;
 	EColumnSortMode::Type ColumnUnusedPercentSortMode = EColumnSortMode::None;
 	EColumnSortMode::Type ColumnUnusedSizeSortMode = EColumnSortMode::None;
+	EColumnSortMode::Type ColumnDiskSizeSortMode = EColumnSortMode::None;
 
 	bool bFilterAssetsUsedActive = false;
 	bool bFilterAssetsPrimaryActive = false;
@@ -136,6 +148,8 @@ private:
 	bool bFilterAssetsExcludedActive = false;
 	bool bFilterAssetsExtReferencedActive = false;
 	bool bFilterAssetsCircularActive = false;
+	bool bFilterAssetsDuplicateActive = false;
+	bool bAssetsDuplicateScanned = false;
 	bool bFilterAssetsUnusedActive = true;
 
 	TSharedPtr<FPjcFilterAssetsUsed> FilterUsed;
@@ -145,6 +159,7 @@ private:
 	TSharedPtr<FPjcFilterAssetsEditor> FilterEditor;
 	TSharedPtr<FPjcFilterAssetsExcluded> FilterExcluded;
 	TSharedPtr<FPjcFilterAssetsExtReferenced> FilterExtReferenced;
+	TSharedPtr<FPjcFilterAssetsDuplicate> FilterDuplicate;
 
 	TArray<FAssetData> AssetsAll;
 	TArray<FAssetData> AssetsUsed;
@@ -155,6 +170,7 @@ private:
 	TArray<FAssetData> AssetsEditor;
 	TArray<FAssetData> AssetsExcluded;
 	TArray<FAssetData> AssetsExtReferenced;
+	TArray<FAssetData> AssetsDuplicate;
 
 	TMap<FString, int32> MapNumAssetsAllByPath;
 	TMap<FString, int32> MapNumAssetsUsedByPath;
@@ -166,11 +182,13 @@ private:
 	int32 NumAssetsAll = 0;
 	int32 NumAssetsUsed = 0;
 	int32 NumAssetsUnused = 0;
+	bool bDeletionResumable = false;
 	int32 NumAssetsPrimary = 0;
 	int32 NumAssetsIndirect = 0;
 	int32 NumAssetsEditor = 0;
 	int32 NumAssetsExcluded = 0;
 	int32 NumAssetsExtReferenced = 0;
+	int32 NumAssetsDuplicate = 0;
 	int32 NumFoldersTotal = 0;
 	int32 NumFoldersEmpty = 0;
 
@@ -182,4 +200,5 @@ private:
 	int64 SizeAssetsEditor = 0;
 	int64 SizeAssetsExcluded = 0;
 	int64 SizeAssetsExtReferenced = 0;
+	int64 SizeAssetsDuplicate = 0;
 };
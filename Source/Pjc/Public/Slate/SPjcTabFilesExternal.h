@@ -15,6 +15,7 @@ public:
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs);
+	virtual ~SPjcTabFilesExternal() override;
 
 protected:
 	void ListUpdateData();
@@ -40,6 +41,7 @@ private:
 	int64 SizeFilesTotal = 0;
 	int64 SizeFilesExcluded = 0;
 	TSharedPtr<FUICommandList> Cmds;
+	FDelegateHandle DelegateHandleContentChanged;
 	TSharedPtr<SComboButton> OptionBtn;
 	UPjcSubsystem* SubsystemPtr = nullptr;
 	TArray<TSharedPtr<FPjcFileExternalItem>> ItemsAll;
@@ -47,6 +49,7 @@ private:
 	TSharedPtr<SListView<TSharedPtr<FPjcFileExternalItem>>> ListView;
 
 	void OnRefresh();
+	void OnContentChanged();
 	void OnDelete();
 	void OnExclude();
 	void OnExcludeByExt();